@@ -0,0 +1,276 @@
+/*
+ * Copyright 2004-2017 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AstArena.h"
+
+#include "misc.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <stdint.h>
+
+/************************************ | *************************************
+*                                                                           *
+* Slabs are kSlabSize bytes and aligned to kSlabSize so that the owning     *
+* slab of any node can be found by masking the node's address.  The slab   *
+* header lives at the front of the slab; the remainder is carved into      *
+* equal-sized slots for one size class.                                     *
+*                                                                           *
+************************************* | ************************************/
+
+static const size_t kSlabSize      = 64 * 1024;
+static const size_t kGranularity   = 16;
+static const size_t kMaxSmallSize  = 1024;
+static const int    kNumClasses    = kMaxSmallSize / kGranularity;
+static const int    kMaxEmptySlabs = 16;
+
+struct FreeSlot {
+  FreeSlot* next;
+};
+
+struct Slab {
+  Slab*     prev;          // links on the owning class' partial list
+  Slab*     next;
+  FreeSlot* freeList;      // slots released back to this slab
+  char*     bump;          // next never-used slot
+  char*     end;           // one past the last slot
+  int       live;          // slots currently handed out
+  int       sizeClass;
+  bool      onPartial;
+};
+
+struct SizeClass {
+  Slab*     partial;       // slabs with at least one free slot
+};
+
+static SizeClass       sClasses[kNumClasses];
+static Slab*           sEmptySlabs     = NULL;
+static int             sNumEmptySlabs  = 0;
+
+static size_t          sBytesInUse     = 0;
+static size_t          sBytesReserved  = 0;
+static size_t          sSlabsInUse     = 0;
+static size_t          sSlabsCreated   = 0;
+static size_t          sSlabsRecycled  = 0;
+static size_t          sSlabsFreed     = 0;
+static size_t          sLargeAllocs    = 0;
+
+static int             sEnabled        = -1;
+
+static bool isEnabled() {
+  if (sEnabled < 0)
+    sEnabled = (getenv("CHPL_DISABLE_AST_ARENA") == NULL) ? 1 : 0;
+
+  return sEnabled == 1;
+}
+
+static inline int classFor(size_t size) {
+  return (int) ((size + kGranularity - 1) / kGranularity) - 1;
+}
+
+static inline size_t slotSize(int sizeClass) {
+  return (size_t) (sizeClass + 1) * kGranularity;
+}
+
+static inline Slab* slabOf(void* ptr) {
+  return (Slab*) ((uintptr_t) ptr & ~(uintptr_t) (kSlabSize - 1));
+}
+
+static void pushPartial(SizeClass& sc, Slab* slab) {
+  slab->prev      = NULL;
+  slab->next      = sc.partial;
+  slab->onPartial = true;
+
+  if (sc.partial != NULL)
+    sc.partial->prev = slab;
+
+  sc.partial = slab;
+}
+
+static void unlinkPartial(SizeClass& sc, Slab* slab) {
+  if (slab->prev != NULL)
+    slab->prev->next = slab->next;
+  else
+    sc.partial       = slab->next;
+
+  if (slab->next != NULL)
+    slab->next->prev = slab->prev;
+
+  slab->prev      = NULL;
+  slab->next      = NULL;
+  slab->onPartial = false;
+}
+
+static Slab* newSlab(int sizeClass) {
+  Slab* slab = NULL;
+
+  if (sEmptySlabs != NULL) {
+    slab        = sEmptySlabs;
+    sEmptySlabs = slab->next;
+    sNumEmptySlabs--;
+    sSlabsRecycled++;
+
+  } else {
+    void* mem = NULL;
+
+    if (posix_memalign(&mem, kSlabSize, kSlabSize) != 0 || mem == NULL)
+      INT_FATAL("out of memory allocating AST arena slab");
+
+    slab = (Slab*) mem;
+    sBytesReserved += kSlabSize;
+    sSlabsCreated++;
+  }
+
+  size_t headerSize = (sizeof(Slab) + kGranularity - 1) & ~(kGranularity - 1);
+  size_t size       = slotSize(sizeClass);
+  size_t numSlots   = (kSlabSize - headerSize) / size;
+
+  slab->prev       = NULL;
+  slab->next       = NULL;
+  slab->freeList   = NULL;
+  slab->bump       = (char*) slab + headerSize;
+  slab->end        = slab->bump + numSlots * size;
+  slab->live       = 0;
+  slab->sizeClass  = sizeClass;
+  slab->onPartial  = false;
+
+  sSlabsInUse++;
+
+  return slab;
+}
+
+// Return a slab whose last node has died.  A few are kept around for
+// reuse so that passes which churn through temporaries don't bounce
+// whole slabs back and forth with the system allocator.
+static void retireSlab(Slab* slab) {
+  sSlabsInUse--;
+
+  if (sNumEmptySlabs < kMaxEmptySlabs) {
+    slab->next  = sEmptySlabs;
+    sEmptySlabs = slab;
+    sNumEmptySlabs++;
+
+  } else {
+    sBytesReserved -= kSlabSize;
+    sSlabsFreed++;
+    free(slab);
+  }
+}
+
+void* AstArena::allocate(size_t size) {
+  if (size > kMaxSmallSize || !isEnabled()) {
+    void* mem = malloc(size);
+
+    if (mem == NULL)
+      throw std::bad_alloc();
+
+    sLargeAllocs++;
+
+    return mem;
+  }
+
+  int        sizeClass = classFor(size);
+  SizeClass& sc        = sClasses[sizeClass];
+  Slab*      slab      = sc.partial;
+  void*      retval    = NULL;
+
+  if (slab == NULL) {
+    slab = newSlab(sizeClass);
+    pushPartial(sc, slab);
+  }
+
+  if (slab->freeList != NULL) {
+    retval         = slab->freeList;
+    slab->freeList = slab->freeList->next;
+
+  } else {
+    retval      = slab->bump;
+    slab->bump += slotSize(sizeClass);
+  }
+
+  slab->live++;
+
+  if (slab->freeList == NULL && slab->bump == slab->end)
+    unlinkPartial(sc, slab);
+
+  sBytesInUse += slotSize(sizeClass);
+
+  return retval;
+}
+
+void AstArena::release(void* ptr, size_t size) {
+  if (ptr == NULL)
+    return;
+
+  if (size > kMaxSmallSize || !isEnabled()) {
+    free(ptr);
+    return;
+  }
+
+  Slab*      slab = slabOf(ptr);
+  SizeClass& sc   = sClasses[slab->sizeClass];
+  FreeSlot*  slot = (FreeSlot*) ptr;
+
+  INT_ASSERT(slab->sizeClass == classFor(size) && slab->live > 0);
+
+  slot->next     = slab->freeList;
+  slab->freeList = slot;
+  slab->live--;
+
+  sBytesInUse -= slotSize(slab->sizeClass);
+
+  if (slab->live == 0) {
+    if (slab->onPartial == true)
+      unlinkPartial(sc, slab);
+
+    retireSlab(slab);
+
+  } else if (slab->onPartial == false) {
+    pushPartial(sc, slab);
+  }
+}
+
+size_t AstArena::bytesInUse() {
+  return sBytesInUse;
+}
+
+size_t AstArena::bytesReserved() {
+  return sBytesReserved;
+}
+
+void AstArena::printStatistics() {
+  if (!isEnabled()) {
+    fprintf(stderr, "    AST arena disabled (CHPL_DISABLE_AST_ARENA)\n");
+    return;
+  }
+
+  fprintf(stderr,
+          "    Arena %9luK in use  %9luK reserved  "
+          "slabs %lu in use  %d empty  %lu created  %lu recycled  %lu freed  "
+          "%lu large\n",
+          (unsigned long) (sBytesInUse    / 1024),
+          (unsigned long) (sBytesReserved / 1024),
+          (unsigned long) sSlabsInUse,
+          sNumEmptySlabs,
+          (unsigned long) sSlabsCreated,
+          (unsigned long) sSlabsRecycled,
+          (unsigned long) sSlabsFreed,
+          (unsigned long) sLargeAllocs);
+}
@@ -19,6 +19,7 @@
 
 #include "baseAST.h"
 
+#include "AstArena.h"
 #include "astutil.h"
 #include "CForLoop.h"
 #include "CatchStmt.h"
@@ -139,6 +140,9 @@ void printStatistics(const char* pass) {
   if (strstr(fPrintStatistics, "k") && !strstr(fPrintStatistics, "n"))
     fprintf(stderr, "    Type %6dK Prim  %6dK Enum %6dK Class %6dK\n",
             kType, kPrimitiveType, kEnumType, kAggregateType);
+  if (strstr(fPrintStatistics, "a"))
+    AstArena::printStatistics();
+
   last_nasts = nasts;
 }
 
@@ -270,6 +274,10 @@ int lastNodeIDUsed() {
   return uid - 1;
 }
 
+int numLiveAstNodes() {
+  return foreach_ast_sep(sum_gvecs, +);
+}
+
 
 // This is here so that we can break on the creation of a particular
 // BaseAST instance in gdb.
@@ -305,6 +313,14 @@ const std::string BaseAST::tabText = "   ";
 BaseAST::~BaseAST() {
 }
 
+void* BaseAST::operator new(size_t size) {
+  return AstArena::allocate(size);
+}
+
+void BaseAST::operator delete(void* ptr, size_t size) {
+  AstArena::release(ptr, size);
+}
+
 int BaseAST::linenum() const {
   return astloc.lineno;
 }
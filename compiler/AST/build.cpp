@@ -1552,13 +1552,36 @@ static BlockStmt* buildLoweredCoforall(Expr* indices,
   VarSymbol* useLocalEndCount = gTrue;
   VarSymbol* countRunningTasks = gTrue;
 
+  VarSymbol* leaves = NULL;
+
   BlockStmt* onBlock = findStmtWithTag(PRIM_BLOCK_ON, body);
   // For remote coforalls (e..g. coforall indices in iterator do on indices) we
   // just do a remote fork instead of creating a task locally. Do not count
   // running tasks locally, and use network atomic EndCounts if available
   if (onBlock) {
-    onBlock->blockInfoGet()->primitive = primitives[PRIM_BLOCK_COFORALL_ON];
-    onBlock->insertAtTail(new CallExpr("_downEndCount", coforallCount));
+    CallExpr* onInfo = onBlock->blockInfoGet();
+
+    onInfo->primitive = primitives[PRIM_BLOCK_COFORALL_ON];
+
+    // When the number of tasks is known up front, tasks may report to a
+    // per-locale leaf that combines their completions (see
+    // _endCountLeavesAlloc() in ChapelBase).  The on's target has
+    // already been evaluated into a temp just before the on block.
+    if (bounded) {
+      VarSymbol* leaf = newTempConst("_coforallLeaf");
+
+      leaves = newTempConst("_coforallLeaves");
+
+      onBlock->insertBefore(new DefExpr(leaf));
+      onBlock->insertBefore(new CallExpr(PRIM_MOVE, leaf,
+                                         new CallExpr("_endCountLeafFor",
+                                                      leaves,
+                                                      onInfo->get(2)->copy())));
+      onBlock->insertAtTail(new CallExpr("_downEndCount", coforallCount, leaf));
+    } else {
+      onBlock->insertAtTail(new CallExpr("_downEndCount", coforallCount));
+    }
+
     addByrefVars(onBlock, byref_vars);
     taskBlk->blockTag = BLOCK_SCOPELESS;
     useLocalEndCount = gFalse;
@@ -1571,9 +1594,15 @@ static BlockStmt* buildLoweredCoforall(Expr* indices,
 
   BlockStmt* block = ForLoop::buildForLoop(indices, new SymExpr(iterator), taskBlk, true, zippered);
   if (bounded) {
+    if (leaves) {
+      block->insertAtHead(new CallExpr(PRIM_MOVE, leaves, new CallExpr("_endCountLeavesAlloc", coforallCount, numTasks)));
+      block->insertAtHead(new DefExpr(leaves));
+    }
     block->insertAtHead(new CallExpr("_upEndCount", coforallCount, countRunningTasks, numTasks));
     block->insertAtHead(new CallExpr(PRIM_MOVE, numTasks, new CallExpr(".", iterator,  new_CStringSymbol("size"))));
     block->insertAtHead(new DefExpr(numTasks));
+    if (leaves)
+      block->insertAtTail(new CallExpr("_endCountLeavesFlush", leaves));
     block->insertAtTail(new CallExpr("_waitEndCount", coforallCount, countRunningTasks, numTasks));
   } else {
     taskBlk->insertBefore(new CallExpr("_upEndCount", coforallCount, countRunningTasks));
@@ -1629,7 +1658,21 @@ static BlockStmt* buildLoweredCoforall(Expr* indices,
 // there are some minor differences. We use network atomics for the EndCount if
 // they're available, we won't manipulate here.runningTaskCount, and we'll use
 // PRIM_BLOCK_COFORALL_ON instead of PRIM_BLOCK_COFORALL so that we just do
-// remote-forks instead of creating any tasks locally.
+// remote-forks instead of creating any tasks locally.  In the bounded case
+// tasks may also report to per-locale leaves that combine their completions:
+//
+//       _upEndCount(_coforallCount, countRunningTasks, numTasks);
+//       var _coforallLeaves = _endCountLeavesAlloc(_coforallCount, numTasks);
+//       for indices in tmpIter {
+//         const tmp = <target locale>;
+//         const _coforallLeaf = _endCountLeafFor(_coforallLeaves, tmp);
+//         /* PRIM_BLOCK_COFORALL_ON (tmp) */ {
+//           body();
+//           _downEndCount(_coforallCount, _coforallLeaf);
+//         }
+//       }
+//       _endCountLeavesFlush(_coforallLeaves);
+//       _waitEndCount(_coforallCount, countRunningTasks, numTasks);
 BlockStmt* buildCoforallLoopStmt(Expr* indices,
                                  Expr* iterator,
                                  CallExpr* byref_vars,
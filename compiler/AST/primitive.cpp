@@ -688,6 +688,8 @@ initPrimitive() {
 
   prim_def(PRIM_LOOKUP_FILENAME, "chpl_lookupFilename", returnInfoStringC, false, false);
 
+  prim_def(PRIM_PROFILE_COUNT, "chpl_prof_count", returnInfoVoid, true, false);
+
   prim_def(PRIM_GET_COMPILER_VAR, "get compiler variable", returnInfoString);
 
   // Allocate a class instance on the stack (where normally it
@@ -21,6 +21,9 @@
 
 #include "codegen.h"
 #include "driver.h"
+#include "misc.h"
+
+#include <vector>
 
 // If vectorization is enabled and this loop is order independent, codegen
 // CHPL_PRAGMA_IVDEP. This method is a no-op if vectorization is off, or the
@@ -48,3 +51,232 @@ void LoopStmt::codegenOrderIndependence()
     info->cStatements.push_back(ivdepStr+'\n');
   }
 }
+
+#ifdef HAVE_LLVM
+
+/************************************ | *************************************
+*                                                                           *
+* Order independent loops under --llvm                                      *
+*                                                                           *
+* The loop id is attached to the latch branch, and every load and store     *
+* generated for the body is tagged with llvm.mem.parallel_loop_access       *
+* (see codegenLoadLLVM and codegenStoreLLVM).  That is LLVM's statement     *
+* that the iterations carry no memory dependences, so the vectorizer does  *
+* not have to prove the absence of aliasing itself.  Accesses in a nested  *
+* parallel loop name the inner loop and every parallel loop around it.     *
+*                                                                           *
+* With --report-vectorized-loops each loop id also carries a chpl.loop.id  *
+* operand.  LLVM ignores loop hints outside the llvm.loop. namespace, and   *
+* copies them when it rewrites the id, so the loop can still be identified *
+* after optimization.                                                       *
+*                                                                           *
+************************************* | ************************************/
+
+struct VectorizedLoopRecord
+{
+  const char* kind;
+  const char* module;
+  const char* filename;
+  int         lineno;
+  bool        isUser;
+};
+
+static std::vector<VectorizedLoopRecord> sReportedLoops;
+
+static const char* kChplLoopId = "chpl.loop.id";
+
+llvm::MDNode* LoopStmt::codegenParallelLoopStart()
+{
+  GenInfo*      info         = gGenInfo;
+  llvm::MDNode* loopMetadata = NULL;
+
+  if (fNoVectorize == false && isOrderIndependent())
+  {
+    llvm::LLVMContext&           ctx = info->module->getContext();
+    std::vector<llvm::Metadata*> args;
+    auto                         tmp = llvm::MDNode::getTemporary(ctx, llvm::None);
+
+    args.push_back(tmp.get());
+
+    if (fReportVectorizedLoops)
+    {
+      ModuleSymbol*        mod    = toModuleSymbol(getModule());
+      VectorizedLoopRecord record;
+
+      record.kind     = astTagAsString();
+      record.module   = mod->name;
+      record.filename = fname();
+      record.lineno   = linenum();
+      record.isUser   = mod->modTag == MOD_USER;
+
+      llvm::Metadata* loopId[] = {
+        llvm::MDString::get(ctx, kChplLoopId),
+        llvm::ConstantAsMetadata::get(
+          llvm::ConstantInt::get(llvm::Type::getInt32Ty(ctx),
+                                 sReportedLoops.size()))
+      };
+
+      args.push_back(llvm::MDNode::get(ctx, loopId));
+
+      sReportedLoops.push_back(record);
+    }
+
+    loopMetadata = llvm::MDNode::get(ctx, args);
+    loopMetadata->replaceOperandWith(0, loopMetadata);
+
+    if (info->loopStack.empty() == false && info->loopStack.top().parallel)
+    {
+      llvm::MDNode*                outer = info->loopStack.top().accessMetadata;
+      std::vector<llvm::Metadata*> loops;
+
+      if (outer == info->loopStack.top().loopMetadata)
+      {
+        loops.push_back(outer);
+      }
+      else
+      {
+        for (unsigned i = 0; i < outer->getNumOperands(); i++)
+          loops.push_back(outer->getOperand(i).get());
+      }
+
+      loops.push_back(loopMetadata);
+
+      info->loopStack.emplace(loopMetadata, llvm::MDNode::get(ctx, loops));
+    }
+    else
+    {
+      info->loopStack.emplace(loopMetadata, true);
+    }
+  }
+
+  return loopMetadata;
+}
+
+// Called at the end of the body.  Loads and stores for the loop's test
+// and increment are not tagged; they carry the loop's dependence on
+// its index.
+void LoopStmt::codegenParallelLoopEnd(llvm::MDNode* loopMetadata)
+{
+  GenInfo* info = gGenInfo;
+
+  if (loopMetadata != NULL)
+  {
+    INT_ASSERT(info->loopStack.top().loopMetadata == loopMetadata);
+
+    info->loopStack.pop();
+  }
+}
+
+void LoopStmt::codegenParallelLoopLatch(llvm::MDNode*      loopMetadata,
+                                        llvm::Instruction* latch)
+{
+  if (loopMetadata != NULL)
+    latch->setMetadata("llvm.loop", loopMetadata);
+}
+
+// Returns the chpl.loop.id in 'loopId', or -1 if it doesn't have one.
+// The loop counts as vectorized only if it is marked llvm.loop.isvectorized
+// with a vectorize.width above 1.  A width of 1 marks a scalar remainder
+// or a loop that was only interleaved.
+static int chplLoopId(llvm::MDNode* loopId, bool* vectorized)
+{
+  int      retval       = -1;
+  bool     isVectorized = false;
+  uint64_t width        = 0;
+
+  for (unsigned i = 1; i < loopId->getNumOperands(); i++)
+  {
+    llvm::MDNode* hint = llvm::dyn_cast<llvm::MDNode>(loopId->getOperand(i));
+
+    if (hint == NULL || hint->getNumOperands() != 2)
+      continue;
+
+    llvm::MDString*           name  =
+      llvm::dyn_cast<llvm::MDString>(hint->getOperand(0));
+    llvm::ConstantAsMetadata* value =
+      llvm::dyn_cast<llvm::ConstantAsMetadata>(hint->getOperand(1));
+
+    if (name == NULL || value == NULL)
+      continue;
+
+    llvm::ConstantInt* intValue =
+      llvm::dyn_cast<llvm::ConstantInt>(value->getValue());
+
+    if (intValue == NULL)
+      continue;
+
+    if (name->getString() == kChplLoopId)
+      retval = intValue->getZExtValue();
+
+    else if (name->getString() == "llvm.loop.isvectorized")
+      isVectorized = intValue->getZExtValue() != 0;
+
+    else if (name->getString() == "llvm.loop.vectorize.width")
+      width = intValue->getZExtValue();
+  }
+
+  *vectorized = isVectorized == true && width > 1;
+
+  return retval;
+}
+
+void LoopStmt::reportVectorizedLoops(llvm::Module* module)
+{
+  std::vector<int> status(sReportedLoops.size(), 0);
+
+  for (llvm::Function& func : *module)
+  {
+    for (llvm::BasicBlock& block : func)
+    {
+      llvm::Instruction* term = block.getTerminator();
+
+      if (term == NULL)
+        continue;
+
+      if (llvm::MDNode* loopId = term->getMetadata("llvm.loop"))
+      {
+        bool vectorized = false;
+        int  id         = chplLoopId(loopId, &vectorized);
+
+        if (id >= 0 && id < (int) status.size() && status[id] != 2)
+          status[id] = (vectorized == true) ? 2 : 1;
+      }
+    }
+  }
+
+  for (size_t i = 0; i < sReportedLoops.size(); i++)
+  {
+    VectorizedLoopRecord& loop = sReportedLoops[i];
+
+    if (developer || loop.isUser)
+    {
+      const char* result = NULL;
+
+      switch (status[i])
+      {
+        case 0:
+          result = "removed by optimization";
+          break;
+
+        case 1:
+          result = "not vectorized";
+          break;
+
+        case 2:
+          result = "vectorized";
+          break;
+      }
+
+      printf("%s:%d: order independent %s in %s %s\n",
+             cleanFilename(loop.filename),
+             loop.lineno,
+             loop.kind,
+             loop.module,
+             result);
+    }
+  }
+
+  sReportedLoops.clear();
+}
+
+#endif
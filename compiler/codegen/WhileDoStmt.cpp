@@ -105,14 +105,22 @@ GenRet WhileDoStmt::codegen()
     info->builder->SetInsertPoint(blockStmtBody);
     info->lvt->addLayer();
 
+    llvm::MDNode*      loopMetadata = codegenParallelLoopStart();
+
     body.codegen("");
 
+    codegenParallelLoopEnd(loopMetadata);
+
     info->lvt->removeLayer();
 
+    llvm::Instruction* endLoopBranch = NULL;
+
     if (blockStmtCond)
-      info->builder->CreateBr(blockStmtCond);
+      endLoopBranch = info->builder->CreateBr(blockStmtCond);
     else
-      info->builder->CreateBr(blockStmtEnd);
+      endLoopBranch = info->builder->CreateBr(blockStmtEnd);
+
+    codegenParallelLoopLatch(loopMetadata, endLoopBranch);
 
     func->getBasicBlockList().push_back(blockStmtEnd);
 
@@ -27,6 +27,7 @@
 #include "files.h"
 #include "insertLineNumbers.h"
 #include "mysystem.h"
+#include "optimizations.h"
 #include "passes.h"
 #include "stmt.h"
 #include "stringutil.h"
@@ -841,6 +842,38 @@ static void genUnwindSymbolTable(){
   genGlobalInt32("chpl_sizeSymTable", symbols.size() * 2);
 }
 
+//
+// Describe the sites instrumented by --profile-gen for the runtime.  Each
+// site has an enclosing function name in chpl_prof_siteNames and a
+// (kind, filename index, line number) triple in chpl_prof_siteInfo.
+//
+static void genProfileSiteTables() {
+  std::vector<GenRet> names;
+  std::vector<GenRet> info;
+
+  for (size_t i = 0; i < gProfileSites.size(); i++) {
+    ProfileSite& site   = gProfileSites[i];
+    int          fileno = getFilenameLookupPosition(site.filename);
+
+    names.push_back(codegenStringForTable(site.name));
+
+    info.push_back(new_IntSymbol(site.kind,   INT_SIZE_32)->codegen());
+    info.push_back(new_IntSymbol(fileno,      INT_SIZE_32)->codegen());
+    info.push_back(new_IntSymbol(site.lineno, INT_SIZE_32)->codegen());
+  }
+
+  // Keep the arrays nonempty
+  names.push_back(codegenStringForTable(""));
+
+  for (int i = 0; i < 3; i++)
+    info.push_back(new_IntSymbol(0, INT_SIZE_32)->codegen());
+
+  codegenGlobalConstArray("chpl_prof_siteNames", "c_string", &names, false);
+  codegenGlobalConstArray("chpl_prof_siteInfo",  "c_int",    &info,  false);
+
+  genGlobalInt32("chpl_prof_numSites", gProfileSites.size());
+}
+
 static bool
 compareSymbol(void* v1, void* v2) {
   Symbol* s1 = (Symbol*)v1;
@@ -1068,6 +1101,9 @@ static void codegen_header_compilation_config() {
     genComment("Unwind symbol tables");
     genUnwindSymbolTable();
 
+    genComment("Profile site tables");
+    genProfileSiteTables();
+
     closeCFile(&cfgfile);
 
     gGenInfo->cfile = save_cfile;
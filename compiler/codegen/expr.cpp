@@ -397,11 +397,11 @@ llvm::StoreInst* codegenStoreLLVM(llvm::Value* val,
 
   if(!info->loopStack.empty()) {
     const auto &loopData = info->loopStack.top();
-    // Currently, the parallel_loop_access metadata refers to the
-    // innermost loop the instruction is in, while for some cases
-    // this could refer to the group of loops it is in.
+    // The parallel_loop_access metadata refers to the innermost
+    // parallel loop the instruction is in and to every parallel loop
+    // enclosing that one.
     if(loopData.parallel)
-      ret->setMetadata(StringRef("llvm.mem.parallel_loop_access"), loopData.loopMetadata);
+      ret->setMetadata(StringRef("llvm.mem.parallel_loop_access"), loopData.accessMetadata);
   }
 
   return ret;
@@ -452,7 +452,7 @@ llvm::LoadInst* codegenLoadLLVM(llvm::Value* ptr,
   if(!info->loopStack.empty()) {
     const auto &loopData = info->loopStack.top();
     if(loopData.parallel)
-      ret->setMetadata(llvm::StringRef("llvm.mem.parallel_loop_access"), loopData.loopMetadata);
+      ret->setMetadata(llvm::StringRef("llvm.mem.parallel_loop_access"), loopData.accessMetadata);
   }
 
   if( tbaa ) ret->setMetadata(llvm::LLVMContext::MD_tbaa, tbaa);
@@ -4889,6 +4889,10 @@ GenRet CallExpr::codegenPrimitive() {
     ret = codegenBasicPrimitiveExpr();
     break;
 
+  case PRIM_PROFILE_COUNT:
+    ret = codegenBasicPrimitiveExpr();
+    break;
+
   case NUM_KNOWN_PRIMS:
     INT_FATAL(this, "impossible");
     break;
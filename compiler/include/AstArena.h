@@ -0,0 +1,55 @@
+/*
+ * Copyright 2004-2017 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _AST_ARENA_H_
+#define _AST_ARENA_H_
+
+#include <cstddef>
+
+//
+// AstArena: a slab allocator for AST nodes.
+//
+// BaseAST overrides operator new/delete to allocate from this arena.
+// Nodes are carved out of large, aligned slabs segregated by size
+// class, so allocating a node is usually a free-list pop or a pointer
+// bump rather than a trip through malloc.
+//
+// Slabs are shared by all passes.  When cleanAst() deletes the last
+// live node in a slab, the whole slab is returned in one step instead
+// of leaving a scattering of small holes in the malloc heap.
+//
+// Setting CHPL_DISABLE_AST_ARENA in the environment falls back to
+// plain malloc/free, which is useful when hunting use-after-free bugs
+// with valgrind or a sanitizer.
+//
+class AstArena {
+public:
+  static void*  allocate(size_t size);
+  static void   release(void* ptr, size_t size);
+
+  static void   printStatistics();
+
+  static size_t bytesInUse();
+  static size_t bytesReserved();
+
+private:
+                AstArena();
+};
+
+#endif
@@ -22,6 +22,15 @@
 
 #include "stmt.h"
 
+#ifdef HAVE_LLVM
+namespace llvm
+{
+  class Instruction;
+  class MDNode;
+  class Module;
+}
+#endif
+
 class LoopStmt : public BlockStmt
 {
 public:
@@ -41,6 +50,10 @@ public:
   bool                   isOrderIndependent()                            const;
   void                   orderIndependentSet(bool b);
 
+#ifdef HAVE_LLVM
+  static void            reportVectorizedLoops(llvm::Module* module);
+#endif
+
 protected:
                          LoopStmt(BlockStmt* initBody);
   virtual               ~LoopStmt();
@@ -50,6 +63,13 @@ protected:
   bool                   mOrderIndependent;
   void                   codegenOrderIndependence();
 
+#ifdef HAVE_LLVM
+  llvm::MDNode*          codegenParallelLoopStart();
+  void                   codegenParallelLoopEnd(llvm::MDNode* loopMetadata);
+  void                   codegenParallelLoopLatch(llvm::MDNode*      loopMetadata,
+                                                  llvm::Instruction* latch);
+#endif
+
 
 private:
                          LoopStmt();
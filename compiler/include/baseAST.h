@@ -258,6 +258,10 @@ public:
 
   static  const       std::string tabText;
 
+  // AST nodes are allocated from the AstArena (see AstArena.h)
+  static void*        operator new(size_t size);
+  static void         operator delete(void* ptr, size_t size);
+
 protected:
                     BaseAST(AstTag type);
   virtual          ~BaseAST();
@@ -275,6 +279,9 @@ GenRet baseASTCodegenString(const char* str);
 // get the current AST node id
 int    lastNodeIDUsed();
 
+// get the number of AST nodes in the global vectors
+int    numLiveAstNodes();
+
 // trace various AST node removals
 void   trace_remove(BaseAST* ast, char flag);
 
@@ -51,10 +51,18 @@ struct LoopData
 {
 #ifdef HAVE_LLVM
   LoopData(llvm::MDNode *loopMetadata, bool parallel)
-    : loopMetadata(loopMetadata), parallel(parallel)
+    : loopMetadata(loopMetadata), parallel(parallel),
+      accessMetadata(loopMetadata)
+  { }
+  LoopData(llvm::MDNode *loopMetadata, llvm::MDNode *accessMetadata)
+    : loopMetadata(loopMetadata), parallel(true),
+      accessMetadata(accessMetadata)
   { }
   llvm::MDNode* loopMetadata;
   bool parallel; /* There is no dependency between loops */
+  /* llvm.mem.parallel_loop_access for memory operations in the body:
+   * this loop's id, or a list of it and every enclosing parallel loop */
+  llvm::MDNode* accessMetadata;
 #endif
 };
 
@@ -40,6 +40,7 @@ extern bool fNoDeadCodeElimination;
 extern bool fNoGlobalConstOpt;
 extern bool fNoFastFollowers;
 extern bool fNoInlineIterators;
+extern bool fNoCacheVisibleFunctions;
 extern bool fNoloopInvariantCodeMotion;
 extern bool fNoInline;
 extern bool fNoLiveAnalysis;
@@ -61,6 +62,9 @@ extern bool fNoOptimizeLoopIterators;
 extern bool fNoVectorize;
 extern bool fNoPrivatization;
 extern bool fNoOptimizeOnClauses;
+extern bool fNoCommCoalescing;
+extern bool fProfileGen;
+extern char fProfileUse[FILENAME_MAX+1];
 extern bool fNoRemoveEmptyRecords;
 extern bool fNoInferLocalFields;
 extern bool fRemoveUnreachableBlocks;
@@ -108,6 +112,7 @@ extern const char* CHPL_UNWIND;
 
 extern bool  printPasses;
 extern FILE* printPassesFile;
+extern FILE* printPassesJsonFile;
 
 // Set true if CHPL_WIDE_POINTERS==struct.
 // In that case, the code generator emits structures
@@ -130,6 +135,7 @@ extern bool fPrintIDonError;
 extern bool fPrintModuleResolution;
 extern bool fPrintEmittedCodeSize;
 extern char fPrintStatistics[256];
+extern int  fBenchmarkAstr;
 extern bool fPrintDispatch;
 extern bool fGenIDS;
 extern bool fLocal;
@@ -176,11 +182,15 @@ extern bool fWarnConstLoops;
 
 extern bool fReportOptimizedLoopIterators;
 extern bool fReportOrderIndependentLoops;
+extern bool fReportVectorizedLoops;
 extern bool fReportOptimizedOn;
 extern bool fReportPromotion;
 extern bool fReportScalarReplace;
 extern bool fReportDeadBlocks;
 extern bool fReportDeadModules;
+extern bool fReportHeapVars;
+extern bool fReportCommCoalescing;
+extern bool fReportProfileUse;
 
 extern bool fStrictErrorHandling;
 
@@ -69,6 +69,27 @@ void freeDefUseChains(std::map<SymExpr*, Vec<SymExpr*>*>& DU,
 
 void remoteValueForwarding();
 
+void coalesceRemoteGets();
+
+// Execution-count profiles: --profile-gen instruments the program with
+// one counter per site, and --profile-use reads the counts back.
+enum ProfileSiteKind {
+  PROFILE_SITE_FN   = 0,          // match CHPL_PROF_SITE_* in the runtime
+  PROFILE_SITE_LOOP = 1
+};
+
+struct ProfileSite {
+  ProfileSiteKind kind;
+  const char*     name;           // the enclosing function
+  const char*     filename;
+  int             lineno;
+};
+
+extern std::vector<ProfileSite> gProfileSites;
+
+void insertProfileCounters();
+void readProfileCounts(std::map<BaseAST*, unsigned long long>& counts);
+
 void inferConstRefs();
 
 
@@ -243,6 +243,8 @@ enum PrimitiveTag {
 
   PRIM_LOOKUP_FILENAME,   // Given an index, get a given filename (c_string)
 
+  PRIM_PROFILE_COUNT,     // Bump the execution counter of a --profile-gen site
+
   PRIM_GET_COMPILER_VAR,
 
   PRIM_STACK_ALLOCATE_CLASS,
@@ -41,6 +41,8 @@ const char* asubstr(const char* s, const char* e);
 
 void        deleteStrings();
 
+void        benchmarkAstr(int rounds);
+
 int8_t      str2int8(const char* str);
 int16_t     str2int16(const char* str);
 int32_t     str2int32(const char* str);
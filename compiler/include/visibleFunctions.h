@@ -22,6 +22,8 @@
 
 #include "vec.h"
 
+#include <cstdio>
+
 class BlockStmt;
 class CallExpr;
 class CallInfo;
@@ -39,4 +41,6 @@ BlockStmt* getVisibilityBlock(Expr* expr);
 
 void       visibleFunctionsClear();
 
+void       visibleFunctionsReportCache(FILE* fp);
+
 #endif
@@ -21,11 +21,15 @@
 
 #include "baseAST.h"
 #include "driver.h"
+#include "version.h"
 
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
 
+#include <sys/resource.h>
+#include <unistd.h>
+
 // Used to collect the times as the program runs
 class Phase
 {
@@ -33,7 +37,8 @@ public:
                            Phase(const char*            name,
                                  int                    passId,
                                  PhaseTracker::SubPhase subPhase,
-                                 unsigned long          startTime);
+                                 unsigned long          startTime,
+                                 PhaseTracker::Memory   memory);
                           ~Phase();
 
   bool                     IsStartOfPass()                            const;
@@ -48,6 +53,7 @@ public:
   int                      mPassId;
   PhaseTracker::SubPhase   mSubPhase;
   unsigned long            mStartTime;  // Elapsed time from main() usecs
+  PhaseTracker::Memory     mMemory;     // Sampled at the start of the phase
 
 private:
   Phase();
@@ -67,6 +73,9 @@ public:
                         unsigned long cleanTime,
                         unsigned long totalTime);
 
+  static void    MemoryHeader(FILE* fp);
+  static void    MemoryFooter(FILE* fp, unsigned long peakRss);
+
   bool           CompareByTime(Pass const& ref)      const;
 
   void           Reset();
@@ -76,12 +85,20 @@ public:
                        unsigned long accumTime, 
                        unsigned long totalTime)      const;
 
+  void           PrintMemory(FILE* fp)               const;
+
+  void           PrintJson(FILE*         fp,
+                           unsigned long startTime,
+                           bool          isLast)     const;
+
   char*          mName;
   int            mPassId;
   int            mIndex;
   unsigned long  mPrimary;          // usecs()
   unsigned long  mVerify;           // usecs()
   unsigned long  mCleanAst;         // usecs()
+  PhaseTracker::Memory mMemStart;   // at the start of the primary phase
+  PhaseTracker::Memory mMemEnd;     // at the start of the next pass
 };
 
 struct SortByTime
@@ -101,6 +118,17 @@ static void PassesReport(FILE*                    fp,
                          const std::vector<Pass>& passes,
                          unsigned long            totalTime);
 
+static void PassesReportMemory(const std::vector<Pass>& passes,
+                               unsigned long            peakRss);
+
+static void PassesReportMemory(FILE*                    fp,
+                               const std::vector<Pass>& passes,
+                               unsigned long            peakRss);
+
+static PhaseTracker::Memory MemorySample();
+
+static void JsonString(FILE* fp, const char* str);
+
 /************************************* | **************************************
 *                                                                             *
 * Implementation of PhaseTracker                                              *
@@ -109,7 +137,8 @@ static void PassesReport(FILE*                    fp,
 
 PhaseTracker::PhaseTracker()
 {
-  mPhaseId = 0;
+  mPhaseId   = 0;
+  mStopMemory = MemorySample();
 
   mTimer.start();
   StartPhase("startup");
@@ -140,7 +169,11 @@ void PhaseTracker::StartPhase(const char* name,
                               int         passId,
                               SubPhase    subPhase)
 {
-  Phase* phase = new Phase(name, passId, subPhase, mTimer.elapsedUsecs());
+  Phase* phase = new Phase(name,
+                           passId,
+                           subPhase,
+                           mTimer.elapsedUsecs(),
+                           MemorySample());
 
   mPhases.push_back(phase);
 }
@@ -148,6 +181,8 @@ void PhaseTracker::StartPhase(const char* name,
 void PhaseTracker::Stop()
 {
   mTimer.stop();
+
+  mStopMemory = MemorySample();
 }
 
 void PhaseTracker::ReportPass() const
@@ -177,12 +212,49 @@ void PhaseTracker::ReportRollup() const
 
   PassesSortByTime(passes);
   PassesReport(passes, totalTime);
+
+  Phase::ReportText("\n\n\n");
+
+  PassesCollect(passes);
+  PassesReportMemory(passes, mStopMemory.mPeakRss);
+}
+
+void PhaseTracker::ReportJson(FILE* fp) const
+{
+  std::vector<Pass> passes;
+  unsigned long     totalTime = mTimer.elapsedUsecs();
+  unsigned long     startTime = 0;
+  char              version[128];
+
+  get_version(version);
+
+  PassesCollect(passes);
+
+  fprintf(fp, "{\n");
+  fprintf(fp, "  \"version\": ");
+  JsonString(fp, version);
+  fprintf(fp, ",\n");
+  fprintf(fp, "  \"totalTime\": %.6f,\n", totalTime / 1e6);
+  fprintf(fp, "  \"peakRssKB\": %lu,\n", mStopMemory.mPeakRss);
+  fprintf(fp, "  \"passes\": [\n");
+
+  for (size_t i = 0; i < passes.size(); i++)
+  {
+    passes[i].PrintJson(fp, startTime, i == passes.size() - 1);
+
+    startTime = startTime + passes[i].TotalTime();
+  }
+
+  fprintf(fp, "  ]\n");
+  fprintf(fp, "}\n");
 }
 
 void PhaseTracker::PassesCollect(std::vector<Pass>& passes) const
 {
   unsigned long totalTime = mTimer.elapsedUsecs();
 
+  passes.clear();
+
   if (mPhases.size() > 0)
   {
     Pass pass;
@@ -200,9 +272,15 @@ void PhaseTracker::PassesCollect(std::vector<Pass>& passes) const
       }
 
       if (i < mPhases.size() - 1)
-        elapsed = mPhases[i + 1]->mStartTime - start;
+      {
+        elapsed        = mPhases[i + 1]->mStartTime - start;
+        pass.mMemEnd   = mPhases[i + 1]->mMemory;
+      }
       else
-        elapsed = totalTime                 - start;
+      {
+        elapsed        = totalTime                 - start;
+        pass.mMemEnd   = mStopMemory;
+      }
 
       switch (mPhases[i]->mSubPhase)
       {
@@ -211,6 +289,7 @@ void PhaseTracker::PassesCollect(std::vector<Pass>& passes) const
           pass.mPassId   = mPhases[i]->mPassId;
           pass.mIndex    = (int) passes.size();
           pass.mPrimary  = elapsed;
+          pass.mMemStart = mPhases[i]->mMemory;
           break;
 
         case PhaseTracker::kVerify:
@@ -271,6 +350,90 @@ static void PassesReport(FILE*                    fp,
   Pass::Footer(fp, mainTime, checkTime, cleanTime, totalTime);
 }
 
+static void PassesReportMemory(const std::vector<Pass>& passes,
+                               unsigned long            peakRss)
+{
+  if (printPasses     == true)
+    PassesReportMemory(stderr, passes, peakRss);
+
+  if (printPassesFile != 0)
+    PassesReportMemory(printPassesFile, passes, peakRss);
+}
+
+static void PassesReportMemory(FILE*                    fp,
+                               const std::vector<Pass>& passes,
+                               unsigned long            peakRss)
+{
+  Pass::MemoryHeader(fp);
+
+  for (size_t i = 0; i < passes.size(); i++)
+    passes[i].PrintMemory(fp);
+
+  Pass::MemoryFooter(fp, peakRss);
+}
+
+/************************************* | **************************************
+*                                                                             *
+* Sample the memory footprint of the compiler.                                *
+*                                                                             *
+* The current RSS is read from /proc where it is available.  The high-water   *
+* mark is the kernel's own, so a pass that briefly spikes the footprint is    *
+* still charged for it even if it frees the memory before it returns.         *
+*                                                                             *
+************************************** | *************************************/
+
+static PhaseTracker::Memory MemorySample()
+{
+  PhaseTracker::Memory retval;
+  struct rusage        usage;
+  FILE*                fp      = fopen("/proc/self/statm", "r");
+
+  retval.mRss     = 0;
+  retval.mPeakRss = 0;
+  retval.mAsts    = numLiveAstNodes();
+
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+#ifdef __APPLE__
+    retval.mPeakRss = usage.ru_maxrss / 1024;   // bytes on Darwin
+#else
+    retval.mPeakRss = usage.ru_maxrss;          // KiB elsewhere
+#endif
+  }
+
+  if (fp != 0)
+  {
+    unsigned long size     = 0;
+    unsigned long resident = 0;
+
+    if (fscanf(fp, "%lu %lu", &size, &resident) == 2)
+      retval.mRss = resident * (sysconf(_SC_PAGESIZE) / 1024);
+
+    fclose(fp);
+  }
+  else
+  {
+    retval.mRss = retval.mPeakRss;
+  }
+
+  return retval;
+}
+
+static void JsonString(FILE* fp, const char* str)
+{
+  fputc('"', fp);
+
+  for (const char* c = str; *c != '\0'; c++)
+  {
+    if (*c == '"' || *c == '\\')
+      fputc('\\', fp);
+
+    fputc(*c, fp);
+  }
+
+  fputc('"', fp);
+}
+
 /************************************* | **************************************
 *                                                                             *
 * Implementation of Phase                                                     *
@@ -280,12 +443,14 @@ static void PassesReport(FILE*                    fp,
 Phase::Phase(const char*            name,
              int                    passId,
              PhaseTracker::SubPhase subPhase,
-             unsigned long          startTime)
+             unsigned long          startTime,
+             PhaseTracker::Memory   memory)
 {
   mName      = (subPhase == PhaseTracker::kPrimary) ? strdup(name) : 0;
   mPassId    = passId;
   mSubPhase  = subPhase;
   mStartTime = startTime;
+  mMemory    = memory;
 }
 
 Phase::~Phase()
@@ -365,6 +530,9 @@ void Pass::Reset()
   mPrimary  = 0;
   mVerify   = 0;
   mCleanAst = 0;
+
+  memset(&mMemStart, 0, sizeof(mMemStart));
+  memset(&mMemEnd,   0, sizeof(mMemEnd));
 }
 
 unsigned long Pass::TotalTime() const
@@ -453,5 +621,75 @@ void Pass::Footer(FILE*         fp,
           totalTime / 1e6);
 }
 
+void Pass::MemoryHeader(FILE* fp)
+{
+  // Print column headers
+  fprintf(fp, "Pass               Name               ");
 
+  fprintf(fp, "   RSS MB   Delta ");
+  fprintf(fp, "  Peak MB   Delta ");
+  fprintf(fp, "      ASTs      Delta");
+  fprintf(fp, "\n");
 
+
+  // Print column underlines
+  fprintf(fp, "---- ---------------------------------");
+
+  fprintf(fp, "  -------- -------");
+  fprintf(fp, "  -------- -------");
+  fprintf(fp, "  --------- ---------");
+  fprintf(fp, "\n");
+}
+
+void Pass::PrintMemory(FILE* fp) const
+{
+  double rss       = mMemEnd.mRss     / 1024.0;
+  double rssDelta  = ((double) mMemEnd.mRss     - mMemStart.mRss)     / 1024.0;
+  double peak      = mMemEnd.mPeakRss / 1024.0;
+  double peakDelta = ((double) mMemEnd.mPeakRss - mMemStart.mPeakRss) / 1024.0;
+
+  if (mPassId > 0)
+    fprintf(fp, "%4d ", mPassId);
+  else
+    fprintf(fp, "     ");
+
+  fprintf(fp, "%-33s", mName);
+  fprintf(fp, "  %8.1f %+7.1f", rss,  rssDelta);
+  fprintf(fp, "  %8.1f %+7.1f", peak, peakDelta);
+  fprintf(fp, "  %9d %+9d", mMemEnd.mAsts, mMemEnd.mAsts - mMemStart.mAsts);
+  fprintf(fp, "\n");
+}
+
+void Pass::MemoryFooter(FILE* fp, unsigned long peakRss)
+{
+  fprintf(fp,
+          "\n     %-33s                    %8.1f\n",
+          "peak memory",
+          peakRss / 1024.0);
+}
+
+void Pass::PrintJson(FILE*         fp,
+                     unsigned long startTime,
+                     bool          isLast) const
+{
+  fprintf(fp, "    {\"id\": %d, \"name\": ", mPassId);
+  JsonString(fp, mName);
+  fprintf(fp,
+          ", \"start\": %.6f, \"main\": %.6f, \"check\": %.6f, "
+          "\"clean\": %.6f,\n",
+          startTime / 1e6,
+          mPrimary  / 1e6,
+          mVerify   / 1e6,
+          mCleanAst / 1e6);
+  fprintf(fp,
+          "     \"rssKB\": %lu, \"rssDeltaKB\": %ld, "
+          "\"peakRssKB\": %lu, \"peakRssDeltaKB\": %ld, "
+          "\"asts\": %d, \"astsDelta\": %d}%s\n",
+          mMemEnd.mRss,
+          (long) mMemEnd.mRss     - (long) mMemStart.mRss,
+          mMemEnd.mPeakRss,
+          (long) mMemEnd.mPeakRss - (long) mMemStart.mPeakRss,
+          mMemEnd.mAsts,
+          mMemEnd.mAsts - mMemStart.mAsts,
+          (isLast == true) ? "" : ",");
+}
@@ -56,6 +56,13 @@
 * of these passes.  Phases that occur before and after the Passes ignore      *
 * the check and clean phases.                                                 *
 *                                                                             *
+* The tracker also samples the resident set size, the process' RSS           *
+* high-water mark, and the number of live AST nodes at the start of every     *
+* phase.  These are reported per pass as the value at the end of the pass   *
+* and the change across it, so that a pass that inflates the compiler's       *
+* footprint can be identified.  ReportJson() writes the same data as a        *
+* machine-readable timeline.                                                  *
+*                                                                             *
 ************************************** | *************************************/
 
 class Phase;
@@ -71,6 +78,13 @@ public:
     kCleanAst
   };
 
+  struct Memory
+  {
+    unsigned long      mRss;            // KiB
+    unsigned long      mPeakRss;        // KiB
+    int                mAsts;
+  };
+
                        PhaseTracker();
                       ~PhaseTracker();
 
@@ -84,6 +98,8 @@ public:
 
   void                 ReportRollup()                                const;
 
+  void                 ReportJson  (FILE* fp)                        const;
+
 private:
   void                 PassesCollect(std::vector<Pass>& passes) const;
   
@@ -94,6 +110,7 @@ private:
   Timer                mTimer;
   int                  mPhaseId;
   std::vector<Phase*>  mPhases;
+  Memory               mStopMemory;
 };
 
 #endif
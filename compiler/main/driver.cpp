@@ -45,6 +45,7 @@
 #include "symbol.h"
 #include "timer.h"
 #include "version.h"
+#include "visibleFunctions.h"
 
 #include <inttypes.h>
 #include <string>
@@ -115,6 +116,7 @@ bool fNoVectorize = true;
 bool fNoGlobalConstOpt = false;
 bool fNoFastFollowers = false;
 bool fNoInlineIterators = false;
+bool fNoCacheVisibleFunctions = false;
 bool fNoLiveAnalysis = false;
 bool fNoBoundsChecks = false;
 bool fNoDivZeroChecks = false;
@@ -132,6 +134,7 @@ bool fStrictErrorHandling = false;
 
 bool  printPasses     = false;
 FILE* printPassesFile = NULL;
+FILE* printPassesJsonFile = NULL;
 
 // flag for llvmWideOpt
 bool fLLVMWideOpt = false;
@@ -147,6 +150,9 @@ bool fNoChecks = false;
 bool fNoInline = false;
 bool fNoPrivatization = false;
 bool fNoOptimizeOnClauses = false;
+bool fNoCommCoalescing = false;
+bool fProfileGen = false;
+char fProfileUse[FILENAME_MAX+1] = "";
 bool fNoRemoveEmptyRecords = true;
 bool fRemoveUnreachableBlocks = true;
 bool fMinimalModules = false;
@@ -179,14 +185,19 @@ bool fPrintIDonError = false;
 bool fPrintModuleResolution = false;
 bool fPrintEmittedCodeSize = false;
 char fPrintStatistics[256] = "";
+int fBenchmarkAstr = 0;
 bool fPrintDispatch = false;
 bool fReportOptimizedLoopIterators = false;
 bool fReportOrderIndependentLoops = false;
+bool fReportVectorizedLoops = false;
 bool fReportOptimizedOn = false;
 bool fReportPromotion = false;
 bool fReportScalarReplace = false;
 bool fReportDeadBlocks = false;
 bool fReportDeadModules = false;
+bool fReportHeapVars = false;
+bool fReportCommCoalescing = false;
+bool fReportProfileUse = false;
 bool printCppLineno = false;
 bool userSetCppLineno = false;
 int num_constants_per_variable = 1;
@@ -632,6 +643,7 @@ static void setFastFlag(const ArgumentDescription* desc, const char* unused) {
   fNoInferLocalFields = false;
   fIgnoreLocalClasses = false;
   fNoOptimizeOnClauses = false;
+  fNoCommCoalescing = false;
   //fReplaceArrayAccessesWithRefTemps = true; // don't tie this to --fast yet
   optimizeCCode = true;
   specializeCCode = true;
@@ -674,6 +686,7 @@ static void setBaselineFlag(const ArgumentDescription* desc, const char* unused)
   fNoTupleCopyOpt = true;             // --no-tuple-copy-opt
   fNoPrivatization = true;            // --no-privatization
   fNoOptimizeOnClauses = true;        // --no-optimize-on-clauses
+  fNoCommCoalescing = true;           // --no-comm-coalescing
   fIgnoreLocalClasses = true;         // --ignore-local-classes
   fNoInferLocalFields = true;         // --no-infer-local-fields
   //fReplaceArrayAccessesWithRefTemps = false; // don't tie this to --baseline yet
@@ -728,6 +741,14 @@ static void setPrintPassesFile(const ArgumentDescription* desc, const char* file
   }
 }
 
+static void setPrintPassesJsonFile(const ArgumentDescription* desc, const char* fileName) {
+  printPassesJsonFile = fopen(fileName, "w");
+
+  if (printPassesJsonFile == NULL) {
+    USR_WARN("Error opening printPassesJsonFile: %s.", fileName);
+  }
+}
+
 static void setLocal (const ArgumentDescription* desc, const char* unused) {
   // Used in postLocal() to set fLocal if user threw flag
   fUserSetLocal = true;
@@ -776,6 +797,7 @@ static ArgumentDescription arg_desc[] = {
  {"", ' ', NULL, "Optimization Control Options", NULL, NULL, NULL, NULL},
  {"baseline", ' ', NULL, "Disable all Chapel optimizations", "F", &fBaseline, "CHPL_BASELINE", setBaselineFlag},
  {"cache-remote", ' ', NULL, "Enable cache for remote data (must be enabled specifically)", "F", &fCacheRemote, "CHPL_CACHE_REMOTE", setCacheEnable},
+ {"comm-coalescing", ' ', NULL, "Enable [disable] coalescing of remote field reads", "n", &fNoCommCoalescing, "CHPL_DISABLE_COMM_COALESCING", NULL},
  {"conditional-dynamic-dispatch-limit", ' ', "<limit>", "Set limit on # of inline conditionals used for dynamic dispatch", "I", &fConditionalDynamicDispatchLimit, "CHPL_CONDITIONAL_DYNAMIC_DISPATCH_LIMIT", NULL},
  {"copy-propagation", ' ', NULL, "Enable [disable] copy propagation", "n", &fNoCopyPropagation, "CHPL_DISABLE_COPY_PROPAGATION", NULL},
  {"dead-code-elimination", ' ', NULL, "Enable [disable] dead code elimination", "n", &fNoDeadCodeElimination, "CHPL_DISABLE_DEAD_CODE_ELIMINATION", NULL},
@@ -791,6 +813,8 @@ static ArgumentDescription arg_desc[] = {
  {"optimize-on-clauses", ' ', NULL, "Enable [disable] optimization of on clauses", "n", &fNoOptimizeOnClauses, "CHPL_DISABLE_OPTIMIZE_ON_CLAUSES", NULL},
  {"optimize-on-clause-limit", ' ', "<limit>", "Limit recursion depth of on clause optimization search", "I", &optimize_on_clause_limit, "CHPL_OPTIMIZE_ON_CLAUSE_LIMIT", NULL},
  {"privatization", ' ', NULL, "Enable [disable] privatization of distributed arrays and domains", "n", &fNoPrivatization, "CHPL_DISABLE_PRIVATIZATION", NULL},
+ {"profile-gen", ' ', NULL, "Instrument the program to record function and loop execution counts", "F", &fProfileGen, "CHPL_PROFILE_GEN", NULL},
+ {"profile-use", ' ', "<file>", "Use execution counts recorded in file to guide inlining", "P", fProfileUse, "CHPL_PROFILE_USE", NULL},
  {"remote-value-forwarding", ' ', NULL, "Enable [disable] remote value forwarding", "n", &fNoRemoteValueForwarding, "CHPL_DISABLE_REMOTE_VALUE_FORWARDING", NULL},
  {"remove-copy-calls", ' ', NULL, "Enable [disable] remove copy calls", "n", &fNoRemoveCopyCalls, "CHPL_DISABLE_REMOVE_COPY_CALLS", NULL},
  {"scalar-replacement", ' ', NULL, "Enable [disable] scalar replacement", "n", &fNoScalarReplacement, "CHPL_DISABLE_SCALAR_REPLACEMENT", NULL},
@@ -842,6 +866,7 @@ static ArgumentDescription arg_desc[] = {
  {"print-commands", ' ', NULL, "[Don't] print system commands", "N", &printSystemCommands, "CHPL_PRINT_COMMANDS", NULL},
  {"print-passes", ' ', NULL, "[Don't] print compiler passes", "N", &printPasses, "CHPL_PRINT_PASSES", NULL},
  {"print-passes-file", ' ', "<filename>", "Print compiler passes to <filename>", "S", NULL, "CHPL_PRINT_PASSES_FILE", setPrintPassesFile},
+ {"print-passes-json", ' ', "<filename>", "Print a JSON pass timeline to <filename>", "S", NULL, "CHPL_PRINT_PASSES_JSON", setPrintPassesJsonFile},
 
  {"", ' ', NULL, "Miscellaneous Options", NULL, NULL, NULL, NULL},
 // Support for extern { c-code-here } blocks could be toggled with this
@@ -915,23 +940,29 @@ static ArgumentDescription arg_desc[] = {
  {"print-emitted-code-size", ' ', NULL, "Print emitted code size", "F", &fPrintEmittedCodeSize, NULL, NULL},
  {"print-module-resolution", ' ', NULL, "Print name of module being resolved", "F", &fPrintModuleResolution, "CHPL_PRINT_MODULE_RESOLUTION", NULL},
  {"print-dispatch", ' ', NULL, "Print dynamic dispatch table", "F", &fPrintDispatch, NULL, NULL},
- {"print-statistics", ' ', "[n|k|t]", "Print AST statistics", "S256", fPrintStatistics, NULL, NULL},
+ {"print-statistics", ' ', "[n|k|t|a]", "Print AST statistics", "S256", fPrintStatistics, NULL, NULL},
  {"report-inlining", ' ', NULL, "Print inlined functions", "F", &report_inlining, NULL, NULL},
+ {"report-comm-coalescing", ' ', NULL, "Print which remote field reads were coalesced into one get", "F", &fReportCommCoalescing, NULL, NULL},
+ {"report-profile-use", ' ', NULL, "Print inlining decisions made from --profile-use counts", "F", &fReportProfileUse, NULL, NULL},
  {"report-dead-blocks", ' ', NULL, "Print dead block removal stats", "F", &fReportDeadBlocks, NULL, NULL},
  {"report-dead-modules", ' ', NULL, "Print dead module removal stats", "F", &fReportDeadModules, NULL, NULL},
+ {"report-heap-vars", ' ', NULL, "Print which variables are moved to the heap for on statements and why", "F", &fReportHeapVars, NULL, NULL},
  {"report-optimized-loop-iterators", ' ', NULL, "Print stats on optimized single loop iterators", "F", &fReportOptimizedLoopIterators, NULL, NULL},
  {"report-order-independent-loops", ' ', NULL, "Print stats on order independent loops", "F", &fReportOrderIndependentLoops, NULL, NULL},
+ {"report-vectorized-loops", ' ', NULL, "Print which order independent loops LLVM vectorized", "F", &fReportVectorizedLoops, NULL, NULL},
  {"report-optimized-on", ' ', NULL, "Print information about on clauses that have been optimized for potential fast remote fork operation", "F", &fReportOptimizedOn, NULL, NULL},
  {"report-promotion", ' ', NULL, "Print information about scalar promotion", "F", &fReportPromotion, NULL, NULL},
  {"report-scalar-replace", ' ', NULL, "Print scalar replacement stats", "F", &fReportScalarReplace, NULL, NULL},
 
  {"", ' ', NULL, "Developer Flags -- Miscellaneous", NULL, NULL, NULL, NULL},
+ {"benchmark-astr", ' ', "<rounds>", "Time interned string lookups over the parsed identifiers", "I", &fBenchmarkAstr, NULL, NULL},
  {"break-on-id", ' ', NULL, "Break when AST id is created", "I", &breakOnID, "CHPL_BREAK_ON_ID", NULL},
  {"break-on-delete-id", ' ', NULL, "Break when AST id is deleted", "I", &breakOnDeleteID, "CHPL_BREAK_ON_DELETE_ID", NULL},
  {"break-on-codegen", ' ', NULL, "Break when function cname is code generated", "S256", &breakOnCodegenCname, "CHPL_BREAK_ON_CODEGEN", NULL},
  {"break-on-codegen-id", ' ', NULL, "Break when id is code generated", "I", &breakOnCodegenID, "CHPL_BREAK_ON_CODEGEN_ID", NULL},
  {"default-dist", ' ', "<distribution>", "Change the default distribution", "S256", defaultDist, "CHPL_DEFAULT_DIST", NULL},
  {"explain-call-id", ' ', "<call-id>", "Explain resolution of call by ID", "I", &explainCallID, NULL, NULL},
+ {"cache-visible-functions", ' ', NULL, "Enable [disable] memoizing visible function lookups", "n", &fNoCacheVisibleFunctions, "CHPL_DISABLE_CACHE_VISIBLE_FUNCTIONS", NULL},
  {"break-on-resolve-id", ' ', NULL, "Break when function call with AST id is resolved", "I", &breakOnResolveID, "CHPL_BREAK_ON_RESOLVE_ID", NULL},
  {"denormalize", ' ', NULL, "Enable [disable] denormalization", "N", &fDenormalize, "CHPL_DENORMALIZE", NULL},
  DRIVER_ARG_DEBUGGERS,
@@ -1197,6 +1228,9 @@ static void checkLLVMCodeGen() {
 #ifndef HAVE_LLVM
  if (llvmCodegen) USR_FATAL("This compiler was built without LLVM support");
 #endif
+
+ if (fReportVectorizedLoops && !llvmCodegen)
+   USR_WARN("--report-vectorized-loops has no effect without --llvm");
 }
 
 static void checkTargetArch() {
@@ -1318,10 +1352,24 @@ int main(int argc, char* argv[]) {
     tracker.ReportRollup();
   }
 
+  if (printPasses == true) {
+    visibleFunctionsReportCache(stderr);
+  }
+
+  if (printPassesFile != NULL) {
+    visibleFunctionsReportCache(printPassesFile);
+  }
+
   if (printPassesFile != NULL) {
     fclose(printPassesFile);
   }
 
+  if (printPassesJsonFile != NULL) {
+    tracker.ReportJson(printPassesJsonFile);
+
+    fclose(printPassesJsonFile);
+  }
+
   clean_exit(0);
 
   return 0;
@@ -0,0 +1,302 @@
+/*
+ * Copyright 2004-2017 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "optimizations.h"
+
+#include "AggregateType.h"
+#include "astutil.h"
+#include "driver.h"
+#include "expr.h"
+#include "stlUtil.h"
+#include "stmt.h"
+#include "stringutil.h"
+#include "symbol.h"
+
+#include <set>
+#include <vector>
+
+/************************************* | **************************************
+*                                                                             *
+* Coalesce remote field reads.                                                *
+*                                                                             *
+* A loop body that reads r.x, r.y and r.z through a wide reference to a       *
+* record generates one GET per field.  When several fields of the record are *
+* read through the same wide reference within a straight-line run of         *
+* statements, and nothing in between can store to memory the reference       *
+* might point to or synchronize with another task, fetch the whole record    *
+* once into a local temp and read the fields from the temp.                   *
+*                                                                             *
+* pre-condition: insertWideReferences has run                                 *
+*                                                                             *
+************************************** | *************************************/
+
+static AggregateType* coalescableRecord(Symbol* base);
+
+static bool           isFieldRead(Expr* stmt, Symbol* base);
+
+static bool           isHarmless(Expr* stmt, Symbol* base);
+
+static Expr*          coalesceFrom(Expr* first);
+
+static void           reportCoalescing(Expr*                       first,
+                                       Symbol*                     base,
+                                       const std::vector<Symbol*>& fields);
+
+void coalesceRemoteGets() {
+  if (fNoCommCoalescing == true || fLocal == true)
+    return;
+
+  forv_Vec(BlockStmt, block, gBlockStmts) {
+    if (block->inTree() == false || isFnSymbol(block->parentSymbol) == false)
+      continue;
+
+    for (Expr* stmt = block->body.head; stmt != NULL; ) {
+      stmt = coalesceFrom(stmt);
+    }
+  }
+}
+
+//
+// If stmt begins a run of reads of two or more fields through the same
+// wide record reference, coalesce the run.  Returns the statement at which
+// to continue scanning.
+//
+static Expr* coalesceFrom(Expr* first) {
+  CallExpr* move = toCallExpr(first);
+
+  if (move == NULL || move->isPrimitive(PRIM_MOVE) == false)
+    return first->next;
+
+  CallExpr* rhs = toCallExpr(move->get(2));
+
+  if (rhs == NULL || rhs->isPrimitive(PRIM_GET_MEMBER_VALUE) == false)
+    return first->next;
+
+  SymExpr*       from = toSymExpr(rhs->get(1));
+  Symbol*        base = from ? from->symbol() : NULL;
+  AggregateType* ag   = base ? coalescableRecord(base) : NULL;
+
+  if (ag == NULL || isFieldRead(first, base) == false)
+    return first->next;
+
+  std::vector<Expr*>   reads;
+  std::vector<Symbol*> fields;
+  std::set<Symbol*>    seen;
+  Expr*                stmt = first;
+
+  while (stmt != NULL) {
+    if (isFieldRead(stmt, base)) {
+      CallExpr* get   = toCallExpr(toCallExpr(stmt)->get(2));
+      Symbol*   field = toSymExpr(get->get(2))->symbol();
+
+      reads.push_back(stmt);
+
+      if (seen.insert(field).second)
+        fields.push_back(field);
+
+    } else if (isHarmless(stmt, base) == false) {
+      break;
+    }
+
+    stmt = stmt->next;
+  }
+
+  // Fetching the whole record only pays off when at least two fields are
+  // read and the record is not much bigger than what is read from it.
+  if (fields.size() < 2 || fields.size() * 2 < (size_t) ag->numFields())
+    return reads.back()->next;
+
+  SET_LINENO(first);
+
+  VarSymbol* tmp = newTemp("coalesce_tmp", ag);
+
+  first->insertBefore(new DefExpr(tmp));
+  first->insertBefore(new CallExpr(PRIM_MOVE,
+                                   tmp,
+                                   new CallExpr(PRIM_DEREF, base)));
+
+  for_vector(Expr, read, reads) {
+    CallExpr* get = toCallExpr(toCallExpr(read)->get(2));
+
+    get->get(1)->replace(new SymExpr(tmp));
+  }
+
+  if (fReportCommCoalescing)
+    reportCoalescing(first, base, fields);
+
+  return reads.back()->next;
+}
+
+//
+// Returns the record type referred to by base if base is a wide reference
+// to a record whose contents may be copied with a single GET.
+//
+static AggregateType* coalescableRecord(Symbol* base) {
+  if (base->isWideRef() == false)
+    return NULL;
+
+  AggregateType* ag = toAggregateType(base->getValType());
+
+  if (ag == NULL || ag->isRecord() == false)
+    return NULL;
+
+  if (ag->symbol->hasFlag(FLAG_ATOMIC_TYPE))
+    return NULL;
+
+  for_fields(field, ag) {
+    if (field->type->symbol->hasFlag(FLAG_ATOMIC_TYPE))
+      return NULL;
+  }
+
+  return ag;
+}
+
+//
+// Is stmt 'move local, (.v base field)' with a value-typed destination?
+//
+static bool isFieldRead(Expr* stmt, Symbol* base) {
+  CallExpr* move = toCallExpr(stmt);
+
+  if (move == NULL || move->isPrimitive(PRIM_MOVE) == false)
+    return false;
+
+  CallExpr* get  = toCallExpr(move->get(2));
+  SymExpr*  lhs  = toSymExpr(move->get(1));
+
+  if (get == NULL || get->isPrimitive(PRIM_GET_MEMBER_VALUE) == false)
+    return false;
+
+  SymExpr*  from  = toSymExpr(get->get(1));
+  SymExpr*  field = toSymExpr(get->get(2));
+
+  return from                     != NULL  &&
+         from->symbol()           == base  &&
+         field                    != NULL  &&
+         field->symbol()->hasFlag(FLAG_SUPER_CLASS) == false &&
+         lhs->symbol()            != base  &&
+         lhs->isRefOrWideRef()    == false;
+}
+
+//
+// Returns true if stmt cannot store to the record base refers to, cannot
+// redefine base, and cannot synchronize with another task.
+//
+// Stores to locals are allowed unless the local is itself a record or a
+// tuple; any other variable is a distinct object from the record.
+//
+static bool isHarmless(Expr* stmt, Symbol* base) {
+  if (isDefExpr(stmt))
+    return true;
+
+  CallExpr* move = toCallExpr(stmt);
+
+  if (move == NULL || move->isPrimitive(PRIM_MOVE) == false)
+    return false;
+
+  Symbol* lhs = toSymExpr(move->get(1))->symbol();
+
+  if (lhs == base || isRecord(lhs->getValType()))
+    return false;
+
+  // Copying a reference is fine, storing through one is not
+  if (SymExpr* rhs = toSymExpr(move->get(2)))
+    return lhs->isRefOrWideRef() == false || rhs->isRefOrWideRef() == true;
+
+  CallExpr* rhs = toCallExpr(move->get(2));
+
+  if (rhs == NULL || rhs->primitive == NULL)
+    return false;
+
+  for_actuals(actual, rhs) {
+    if (isSymExpr(actual) == false)
+      return false;
+  }
+
+  if (lhs->isRefOrWideRef()) {
+    switch (rhs->primitive->tag) {
+      case PRIM_ADDR_OF:
+      case PRIM_SET_REFERENCE:
+      case PRIM_GET_MEMBER:
+      case PRIM_GET_SVEC_MEMBER:
+        return true;
+
+      default:
+        return false;
+    }
+  }
+
+  switch (rhs->primitive->tag) {
+    case PRIM_GET_MEMBER_VALUE:
+    case PRIM_GET_SVEC_MEMBER_VALUE:
+    case PRIM_DEREF:
+    case PRIM_CAST:
+    case PRIM_UNARY_MINUS:
+    case PRIM_UNARY_PLUS:
+    case PRIM_UNARY_NOT:
+    case PRIM_UNARY_LNOT:
+    case PRIM_ADD:
+    case PRIM_SUBTRACT:
+    case PRIM_MULT:
+    case PRIM_DIV:
+    case PRIM_MOD:
+    case PRIM_LSH:
+    case PRIM_RSH:
+    case PRIM_EQUAL:
+    case PRIM_NOTEQUAL:
+    case PRIM_LESSOREQUAL:
+    case PRIM_GREATEROREQUAL:
+    case PRIM_LESS:
+    case PRIM_GREATER:
+    case PRIM_AND:
+    case PRIM_OR:
+    case PRIM_XOR:
+    case PRIM_POW:
+    case PRIM_GET_REAL:
+    case PRIM_GET_IMAG:
+    case PRIM_WIDE_GET_LOCALE:
+    case PRIM_WIDE_GET_NODE:
+    case PRIM_WIDE_GET_ADDR:
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+static void reportCoalescing(Expr*                       first,
+                             Symbol*                     base,
+                             const std::vector<Symbol*>& fields) {
+  ModuleSymbol* mod = first->getModule();
+
+  if (developer == false &&
+      (mod->modTag == MOD_INTERNAL || mod->modTag == MOD_STANDARD))
+    return;
+
+  printf("%s:%d: coalesced %d remote field reads of %s into one get:",
+         first->fname(),
+         first->linenum(),
+         (int) fields.size(),
+         base->getValType()->symbol->name);
+
+  for_vector(Symbol, field, fields) {
+    printf(" %s", field->name);
+  }
+
+  printf("\n");
+}
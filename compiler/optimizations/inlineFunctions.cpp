@@ -22,16 +22,22 @@
 #include "astutil.h"
 #include "driver.h"
 #include "expr.h"
+#include "LoopStmt.h"
 #include "optimizations.h"
 #include "stlUtil.h"
 #include "stmt.h"
 #include "stringutil.h"
 
+#include <algorithm>
+#include <map>
 #include <set>
 #include <vector>
 
+typedef std::map<BaseAST*, unsigned long long> ProfileCounts;
+
 static void updateRefCalls();
 static void inlineFunctionsImpl();
+static void inlineHotCalls(ProfileCounts& counts);
 static void inlineFunction(FnSymbol* fn, std::set<FnSymbol*>& inlinedSet);
 static void inlineCall(CallExpr* call);
 static void updateDerefCalls();
@@ -45,12 +51,24 @@ static void inlineCleanup();
 ************************************** | *************************************/
 
 void inlineFunctions() {
+  ProfileCounts counts;
+
+  if (fProfileGen == true)
+    insertProfileCounters();
+
   compute_call_sites();
 
   updateRefCalls();
 
+  // Match the counts to functions and loops before inlining copies them
+  if (fProfileUse[0] != '\0')
+    readProfileCounts(counts);
+
   inlineFunctionsImpl();
 
+  if (fProfileUse[0] != '\0' && fNoInline == false)
+    inlineHotCalls(counts);
+
   updateDerefCalls();
 
   inlineCleanup();
@@ -167,6 +185,143 @@ static void inlineAtCallSites(FnSymbol* fn) {
   }
 }
 
+/************************************* | **************************************
+*                                                                             *
+* Profile-guided inlining.                                                    *
+*                                                                             *
+* With --profile-use, also inline calls to small functions that the profile   *
+* shows to be hot.  A function is hot if it was entered at least              *
+* kMinHotCount times and at least 1/kHotFraction as often as the most         *
+* frequently entered function.  It is small if its body has no more than      *
+* kMaxHotCalleeSize calls; a call made from inside a hot loop may inline a    *
+* callee twice that size.  Each call is inlined once, so a chain of hot       *
+* calls is flattened by at most one level per callee.                         *
+*                                                                             *
+************************************** | *************************************/
+
+static const unsigned long long kMinHotCount      = 1000;
+static const unsigned long long kHotFraction      = 100;
+static const int                kMaxHotCalleeSize = 40;
+
+static const char* notHotInlinable(FnSymbol* fn);
+static int         calleeSize(FnSymbol* fn);
+static bool        isInHotLoop(CallExpr*            call,
+                               ProfileCounts&       counts,
+                               unsigned long long   threshold);
+static bool        shouldReport(BaseAST* ast);
+
+static void inlineHotCalls(ProfileCounts& counts) {
+  unsigned long long maxCount  = 0;
+  unsigned long long threshold = 0;
+
+  for (ProfileCounts::iterator it = counts.begin(); it != counts.end(); ++it) {
+    if (isFnSymbol(it->first) && it->second > maxCount)
+      maxCount = it->second;
+  }
+
+  threshold = std::max(kMinHotCount, maxCount / kHotFraction);
+
+  // Calls copied by the inlining above are not in the calledBy lists yet
+  compute_call_sites();
+
+  forv_Vec(FnSymbol, fn, gFnSymbols) {
+    if (counts.count(fn) == 0 || counts[fn] < threshold || !fn->inTree())
+      continue;
+
+    if (const char* reason = notHotInlinable(fn)) {
+      if (fReportProfileUse && shouldReport(fn))
+        printf("%s:%d: hot function %s (%llu calls) not inlined: %s\n",
+               fn->fname(), fn->linenum(), fn->name, counts[fn], reason);
+      continue;
+    }
+
+    forv_Vec(CallExpr, call, *fn->calledBy) {
+      if (call->parentSymbol       == NULL  ||
+          call->isResolved()       == false ||
+          call->getFunction()      == fn)
+        continue;
+
+      int  size  = calleeSize(fn);
+      int  limit = kMaxHotCalleeSize;
+
+      if (isInHotLoop(call, counts, threshold))
+        limit *= 2;
+
+      if (size > limit) {
+        if (fReportProfileUse && shouldReport(call))
+          printf("%s:%d: hot call to %s (%llu calls) not inlined: "
+                 "size %d exceeds %d\n",
+                 call->fname(), call->linenum(), fn->name, counts[fn],
+                 size, limit);
+        continue;
+      }
+
+      if (fReportProfileUse && shouldReport(call))
+        printf("%s:%d: inlined hot call to %s (%llu calls, size %d)\n",
+               call->fname(), call->linenum(), fn->name, counts[fn], size);
+
+      inlineCall(call);
+    }
+  }
+}
+
+//
+// Returns why fn may not be inlined at its hot call sites, or NULL if it may
+//
+static const char* notHotInlinable(FnSymbol* fn) {
+  std::vector<CallExpr*> calls;
+
+  if (fn->hasFlag(FLAG_EXTERN)                    ||
+      fn->hasFlag(FLAG_NO_CODEGEN))
+    return "no body";
+
+  if (fn->hasFlag(FLAG_ON)                        ||
+      fn->hasFlag(FLAG_ON_BLOCK)                  ||
+      fn->hasFlag(FLAG_BEGIN)                     ||
+      fn->hasFlag(FLAG_BEGIN_BLOCK)               ||
+      fn->hasFlag(FLAG_COBEGIN_OR_COFORALL)       ||
+      fn->hasFlag(FLAG_COBEGIN_OR_COFORALL_BLOCK))
+    return "task function";
+
+  collectFnCalls(fn, calls);
+
+  for_vector(CallExpr, call, calls) {
+    if (call->resolvedFunction() == fn)
+      return "recursive";
+  }
+
+  return NULL;
+}
+
+static int calleeSize(FnSymbol* fn) {
+  std::vector<CallExpr*> calls;
+
+  collectCallExprs(fn->body, calls);
+
+  return (int) calls.size();
+}
+
+static bool isInHotLoop(CallExpr*            call,
+                        ProfileCounts&       counts,
+                        unsigned long long   threshold) {
+  for (Expr* expr = call->parentExpr; expr != NULL; expr = expr->parentExpr) {
+    if (LoopStmt* loop = toLoopStmt(expr)) {
+      if (counts.count(loop) != 0 && counts[loop] >= threshold)
+        return true;
+    }
+  }
+
+  return false;
+}
+
+// Only report on user code unless this is a developer
+static bool shouldReport(BaseAST* ast) {
+  ModuleSymbol* mod = ast->getModule();
+
+  return developer == true ||
+         (mod->modTag != MOD_INTERNAL && mod->modTag != MOD_STANDARD);
+}
+
 /************************************* | **************************************
 *                                                                             *
 * inlines the function called by 'call' at that call site                     *
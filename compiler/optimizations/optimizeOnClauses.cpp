@@ -131,6 +131,7 @@ classifyPrimitive(CallExpr *call) {
   case PRIM_GET_USER_LINE:
   case PRIM_GET_USER_FILE:
   case PRIM_LOOKUP_FILENAME:
+  case PRIM_PROFILE_COUNT:
 
   case PRIM_STACK_ALLOCATE_CLASS:
     return FAST_AND_LOCAL;
@@ -0,0 +1,236 @@
+/*
+ * Copyright 2004-2017 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "optimizations.h"
+
+#include "astutil.h"
+#include "driver.h"
+#include "expr.h"
+#include "LoopStmt.h"
+#include "stlUtil.h"
+#include "stmt.h"
+#include "stringutil.h"
+#include "symbol.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+/************************************* | **************************************
+*                                                                             *
+* Execution-count profiles.                                                   *
+*                                                                             *
+* A --profile-gen compile gives every function and every loop a numbered      *
+* site and bumps the site's counter on each function entry or loop            *
+* iteration.  Site numbers need not agree from one compile to the next, so    *
+* the runtime writes each count out against the site's kind, file, line and   *
+* enclosing function.  A --profile-use compile enumerates the same sites and  *
+* looks their counts up by that key.  Sites that share a key, such as the     *
+* instantiations of a generic function, share the summed count.              *
+*                                                                             *
+* pre-condition: lowerIterators has run, so every loop is a C-style loop, a   *
+* while loop or a do-while loop.                                              *
+*                                                                             *
+************************************** | *************************************/
+
+std::vector<ProfileSite> gProfileSites;
+
+static void        collectProfileSites(std::vector<FnSymbol*>& fns,
+                                       std::vector<LoopStmt*>& loops);
+
+static bool        isProfiledFunction(FnSymbol* fn);
+
+static CallExpr*   newProfileCount(ProfileSiteKind kind,
+                                   const char*     name,
+                                   BaseAST*        ast);
+
+static std::string profileKey(ProfileSiteKind kind,
+                              const char*     name,
+                              const char*     filename,
+                              int             lineno);
+
+static bool        readProfileFile(const char*                                path,
+                                   std::map<std::string, unsigned long long>& counts);
+
+void insertProfileCounters() {
+  std::vector<FnSymbol*> fns;
+  std::vector<LoopStmt*> loops;
+
+  collectProfileSites(fns, loops);
+
+  for_vector(FnSymbol, fn, fns) {
+    SET_LINENO(fn);
+
+    fn->body->insertAtHead(newProfileCount(PROFILE_SITE_FN, fn->name, fn));
+  }
+
+  for_vector(LoopStmt, loop, loops) {
+    const char* name = loop->getFunction()->name;
+
+    SET_LINENO(loop);
+
+    loop->insertAtHead(newProfileCount(PROFILE_SITE_LOOP, name, loop));
+  }
+}
+
+void readProfileCounts(std::map<BaseAST*, unsigned long long>& counts) {
+  std::map<std::string, unsigned long long> byKey;
+  std::vector<FnSymbol*>                    fns;
+  std::vector<LoopStmt*>                    loops;
+
+  if (readProfileFile(fProfileUse, byKey) == false)
+    USR_FATAL("could not open profile file '%s'", fProfileUse);
+
+  // Locales other than 0 write their counts to <file>.<locale>
+  for (int node = 1; readProfileFile(astr(fProfileUse, ".", istr(node)),
+                                     byKey); node++) {
+  }
+
+  collectProfileSites(fns, loops);
+
+  for_vector(FnSymbol, fn, fns) {
+    std::string key = profileKey(PROFILE_SITE_FN,
+                                 fn->name,
+                                 fn->fname(),
+                                 fn->linenum());
+
+    if (byKey.count(key) != 0)
+      counts[fn] = byKey[key];
+  }
+
+  for_vector(LoopStmt, loop, loops) {
+    std::string key = profileKey(PROFILE_SITE_LOOP,
+                                 loop->getFunction()->name,
+                                 loop->fname(),
+                                 loop->linenum());
+
+    if (byKey.count(key) != 0)
+      counts[loop] = byKey[key];
+  }
+}
+
+static void collectProfileSites(std::vector<FnSymbol*>& fns,
+                                std::vector<LoopStmt*>& loops) {
+  forv_Vec(FnSymbol, fn, gFnSymbols) {
+    if (isProfiledFunction(fn))
+      fns.push_back(fn);
+  }
+
+  forv_Vec(BlockStmt, block, gBlockStmts) {
+    if (block->inTree() == true && block->isLoopStmt() == true) {
+      FnSymbol* fn = toFnSymbol(block->parentSymbol);
+
+      if (fn != NULL && isProfiledFunction(fn))
+        loops.push_back(toLoopStmt(block));
+    }
+  }
+}
+
+static bool isProfiledFunction(FnSymbol* fn) {
+  return fn->inTree()                  == true  &&
+         fn->hasFlag(FLAG_EXTERN)      == false &&
+         fn->hasFlag(FLAG_NO_CODEGEN)  == false;
+}
+
+static CallExpr* newProfileCount(ProfileSiteKind kind,
+                                 const char*     name,
+                                 BaseAST*        ast) {
+  ProfileSite site = { kind, name, ast->fname(), ast->linenum() };
+  int         id   = (int) gProfileSites.size();
+
+  gProfileSites.push_back(site);
+
+  return new CallExpr(PRIM_PROFILE_COUNT, new_IntSymbol(id, INT_SIZE_32));
+}
+
+//
+// The runtime names files the way the filename table does, with a leading
+// $CHPL_HOME in place of its value, so profiles survive a moved install.
+//
+static std::string profileKey(ProfileSiteKind kind,
+                              const char*     name,
+                              const char*     filename,
+                              int             lineno) {
+  std::string key  = (kind == PROFILE_SITE_LOOP) ? "loop\t" : "fn\t";
+  size_t      home = strlen(CHPL_HOME);
+
+  if (strncmp(filename, CHPL_HOME, home) == 0) {
+    key += "$CHPL_HOME";
+    key += filename + home;
+  } else {
+    key += filename;
+  }
+
+  key += "\t";
+  key += istr(lineno);
+  key += "\t";
+  key += name;
+
+  return key;
+}
+
+//
+// Each line is kind, count, file, line and name separated by tabs.
+// Returns false if the file cannot be opened.
+//
+static bool readProfileFile(const char*                                path,
+                            std::map<std::string, unsigned long long>& counts) {
+  FILE* fp     = fopen(path, "r");
+  char  line[4096];
+  int   lineno = 0;
+
+  if (fp == NULL)
+    return false;
+
+  while (fgets(line, sizeof(line), fp) != NULL) {
+    char*              fields[5];
+    int                numFields = 0;
+    char*              end       = NULL;
+    unsigned long long count     = 0;
+
+    lineno++;
+
+    if (line[0] == '#' || line[0] == '\n')
+      continue;
+
+    line[strcspn(line, "\n")] = '\0';
+
+    for (char* field = line; field != NULL && numFields < 5; numFields++) {
+      fields[numFields] = field;
+
+      if ((field = strchr(field, '\t')) != NULL)
+        *field++ = '\0';
+    }
+
+    if (numFields == 5)
+      count = strtoull(fields[1], &end, 10);
+
+    if (numFields != 5 || end == fields[1] || *end != '\0' ||
+        (strcmp(fields[0], "fn") != 0 && strcmp(fields[0], "loop") != 0))
+      USR_FATAL("malformed profile file '%s' at line %d", path, lineno);
+
+    counts[std::string(fields[0]) + "\t" + fields[2] + "\t" +
+           fields[3]              + "\t" + fields[4]] += count;
+  }
+
+  fclose(fp);
+
+  return true;
+}
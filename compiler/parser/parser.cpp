@@ -96,6 +96,10 @@ void parse() {
 
   finishCountingTokens();
 
+  if (fBenchmarkAstr > 0) {
+    benchmarkAstr(fBenchmarkAstr);
+  }
+
   parsed = true;
 }
 
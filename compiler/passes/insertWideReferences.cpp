@@ -2535,6 +2535,10 @@ insertWideReferences(void) {
 
   handleIsWidePointer();
 
+  // Now that we know which references are wide, fetch records read a
+  // field at a time through the same wide reference in one GET.
+  coalesceRemoteGets();
+
 
 #ifdef PRINT_WIDEN_SUMMARY
   printf("Spent %2.3f seconds propagating vars\n", debugTimer.elapsedSecs());
@@ -34,6 +34,9 @@
 #include "stringutil.h"
 #include "symbol.h"
 
+#include <map>
+#include <set>
+
 // Notes on
 //   makeHeapAllocations()    //invoked from parallel()
 //   insertWideReferences()
@@ -66,6 +69,8 @@
 //    requireWideReferences()
 // - for a local - in MHA, if:
 //    needHeapVars() && the local can be passed to an 'on'
+//   The heap copy is freed at the end of the local's block unless
+//   its address can reach a 'begin' (see findHeapVarEscape()).
 //
 // Change acces to variable -> access to its ._value
 // - for globals - in MHA, if:
@@ -531,6 +536,50 @@ static CallExpr* findDownEndCount(FnSymbol* fn)
 }
 
 
+// Find the arg bundle field that carries 'actual', an argument of the
+// downEndCount call in task function 'fn'.
+static Symbol* findDownEndCountField(FnSymbol* fn, CallExpr* downEndCount,
+                                     Expr* actual, AggregateType* ctype)
+{
+  Expr* endCountTmp = actual;
+  Expr* cur = downEndCount->prev;
+  ArgSymbol* whichArg = NULL;
+  // Which argument is passed to the downEndCount?
+  // This loop is meant to handle control-flow regions only.
+  while (true) {
+    SymExpr* se = toSymExpr(endCountTmp);
+    if (ArgSymbol* arg = toArgSymbol(se->symbol())) {
+      whichArg = arg;
+      break;
+    }
+    if (cur == NULL)
+      break; // out of AST
+    if (CallExpr* call = toCallExpr(cur))
+      if (call->isPrimitive(PRIM_MOVE))
+        if (SymExpr* dst = toSymExpr(call->get(1)))
+          if (dst->symbol() == se->symbol()) {
+            if (SymExpr* src = toSymExpr(call->get(2)))
+              endCountTmp = src;
+            else if (CallExpr* subcall = toCallExpr(call->get(2)))
+              if (subcall->isPrimitive(PRIM_DEREF))
+                endCountTmp = subcall->get(1);
+          }
+    cur = cur->prev;
+  }
+
+  INT_ASSERT(whichArg != NULL);
+
+  // figure out which arg is the i'th arg
+  int i = 1;
+  for_formals(formal, fn) {
+    if (formal == whichArg) break;
+    i++;
+  }
+  INT_ASSERT(i <= fn->numFormals());
+
+  return ctype->getField(i+1); // +1 for rt header
+}
+
 static void moveDownEndCountToWrapper(FnSymbol* fn, FnSymbol* wrap_fn, Symbol* wrap_c, AggregateType* ctype)
 {
   if (fn->hasFlag(FLAG_NON_BLOCKING) ||
@@ -542,66 +591,39 @@ static void moveDownEndCountToWrapper(FnSymbol* fn, FnSymbol* wrap_fn, Symbol* w
     // Move the downEndCount to the wrapper function.
 
     FnSymbol* downEndCountFn = downEndCount->resolvedFunction();
+    CallExpr* wrapDownEndCount = new CallExpr(downEndCountFn);
 
-    Expr* endCountTmp = downEndCount->get(1);
-    Expr* cur = downEndCount->prev;
-    ArgSymbol* whichArg = NULL;
-    // Which argument is passed to the downEndCount?
-    // This loop is meant to handle control-flow regions only.
-    while (true) {
-      SymExpr* se = toSymExpr(endCountTmp);
-      if (ArgSymbol* arg = toArgSymbol(se->symbol())) {
-        whichArg = arg;
-        break;
-      }
-      if (cur == NULL)
-        break; // out of AST
-      if (CallExpr* call = toCallExpr(cur))
-        if (call->isPrimitive(PRIM_MOVE))
-          if (SymExpr* dst = toSymExpr(call->get(1)))
-            if (dst->symbol() == se->symbol()) {
-              if (SymExpr* src = toSymExpr(call->get(2)))
-                endCountTmp = src;
-              else if (CallExpr* subcall = toCallExpr(call->get(2)))
-                if (subcall->isPrimitive(PRIM_DEREF))
-                  endCountTmp = subcall->get(1);
-            }
-      cur = cur->prev;
-    }
-
-    INT_ASSERT(whichArg != NULL);
+    // Each actual -- the end count, and for coforall+ons the per-locale
+    // leaf -- is a formal of the task fn.  Get the corresponding class
+    // member and pass that instead.
+    for_actuals(actual, downEndCount) {
+      Symbol* field = findDownEndCountField(fn, downEndCount, actual, ctype);
 
-    // figure out which arg is the i'th arg
-    int i = 1;
-    for_formals(formal, fn) {
-      if (formal == whichArg) break;
-      i++;
-    }
-    INT_ASSERT(i <= fn->numFormals());
-    // Now get the i'th class member. It should be an end count.
-    // Change that to the downEndCount call.
+      // The first one should be an end count.
+      INT_ASSERT(actual != downEndCount->get(1) ||
+                 field->getValType()->symbol->hasFlag(FLAG_END_COUNT));
 
-    Symbol *field = ctype->getField(i+1); // +1 for rt header
-    INT_ASSERT(field->getValType()->symbol->hasFlag(FLAG_END_COUNT));
+      VarSymbol* tmp = newTemp("endcount", field->qualType());
+      wrap_fn->insertAtTail(new DefExpr(tmp));
+      wrap_fn->insertAtTail(
+          new CallExpr(PRIM_MOVE, tmp,
+          new CallExpr(PRIM_GET_MEMBER_VALUE, wrap_c, field)));
 
-    VarSymbol* tmp = newTemp("endcount", field->qualType());
-    wrap_fn->insertAtTail(new DefExpr(tmp));
-    wrap_fn->insertAtTail(
-        new CallExpr(PRIM_MOVE, tmp,
-        new CallExpr(PRIM_GET_MEMBER_VALUE, wrap_c, field)));
+      if (field->isRef()) {
+        VarSymbol* derefTmp = newTemp("endcountDeref", field->type->getValType());
+        wrap_fn->insertAtTail(new DefExpr(derefTmp));
+        wrap_fn->insertAtTail(
+            new CallExpr(PRIM_MOVE, derefTmp,
+            new CallExpr(PRIM_DEREF, tmp)));
 
-    if (field->isRef()) {
-      VarSymbol* derefTmp = newTemp("endcountDeref", field->type->getValType());
-      wrap_fn->insertAtTail(new DefExpr(derefTmp));
-      wrap_fn->insertAtTail(
-          new CallExpr(PRIM_MOVE, derefTmp,
-          new CallExpr(PRIM_DEREF, tmp)));
+        tmp = derefTmp;
+      }
 
-      tmp = derefTmp;
+      wrapDownEndCount->insertAtTail(tmp);
     }
 
     // Call downEndCount in the wrapper.
-    wrap_fn->insertAtTail(new CallExpr(downEndCountFn, tmp));
+    wrap_fn->insertAtTail(wrapDownEndCount);
 
     // Remove downEndCount from the task fn since it
     // is now in the wrapper.
@@ -897,26 +919,241 @@ buildHeapType(Type* type) {
 }
 
 
-static void
-freeHeapAllocatedVars(Vec<Symbol*> heapAllocatedVars) {
-  Vec<FnSymbol*> fnsContainingTaskll;
+// Can the pointer to heap-allocated 'var' outlive the block that
+// declares it?  on, cobegin and coforall bodies are joined (through
+// their end counts) before control leaves the block that starts them,
+// so passing 'var' to one of them is harmless; only a begin can still
+// be running when the block exits.
+//
+// Follow every symbol that may hold the address of 'var' -- refs and
+// copies of the heap pointer, including callee formals -- and return
+// the expression through which it escapes, or NULL if it is contained.
+// Reads of the value (GET_MEMBER_VALUE, moves into non-ref temps) do
+// not carry the address and are not followed.  Any other primitive, or
+// a call that is not resolved to a known function, is assumed to let
+// the address escape.
+static bool
+mayHoldHeapVarAddress(Symbol* sym) {
+  return sym->isRef() || sym->type->symbol->hasFlag(FLAG_HEAP);
+}
 
-  // start with functions created by begin statements
-  forv_Vec(FnSymbol, fn, gFnSymbols) {
-    if (fn->hasFlag(FLAG_BEGIN))
-      fnsContainingTaskll.add(fn);
+// Primitives that only read or update the values of their operands, so
+// cannot pass on the address of a heap variable given to them.
+static bool
+isValueOnlyPrimitive(CallExpr* call) {
+  switch (call->primitive->tag) {
+  case PRIM_NOOP:
+  case PRIM_UNARY_MINUS:
+  case PRIM_UNARY_PLUS:
+  case PRIM_UNARY_NOT:
+  case PRIM_UNARY_LNOT:
+  case PRIM_ADD:
+  case PRIM_SUBTRACT:
+  case PRIM_MULT:
+  case PRIM_DIV:
+  case PRIM_MOD:
+  case PRIM_LSH:
+  case PRIM_RSH:
+  case PRIM_EQUAL:
+  case PRIM_NOTEQUAL:
+  case PRIM_LESSOREQUAL:
+  case PRIM_GREATEROREQUAL:
+  case PRIM_LESS:
+  case PRIM_GREATER:
+  case PRIM_AND:
+  case PRIM_OR:
+  case PRIM_XOR:
+  case PRIM_POW:
+  case PRIM_ADD_ASSIGN:
+  case PRIM_SUBTRACT_ASSIGN:
+  case PRIM_MULT_ASSIGN:
+  case PRIM_DIV_ASSIGN:
+  case PRIM_MOD_ASSIGN:
+  case PRIM_LSH_ASSIGN:
+  case PRIM_RSH_ASSIGN:
+  case PRIM_AND_ASSIGN:
+  case PRIM_OR_ASSIGN:
+  case PRIM_XOR_ASSIGN:
+  case PRIM_MIN:
+  case PRIM_MAX:
+  case PRIM_GET_MEMBER_VALUE:
+  case PRIM_GET_SVEC_MEMBER_VALUE:
+  case PRIM_DEREF:
+  case PRIM_CHECK_NIL:
+  case PRIM_LOCAL_CHECK:
+  case PRIM_GETCID:
+  case PRIM_TESTCID:
+  case PRIM_PTR_EQUAL:
+  case PRIM_PTR_NOTEQUAL:
+  case PRIM_WIDE_GET_LOCALE:
+  case PRIM_WIDE_GET_NODE:
+  case PRIM_IS_WIDE_PTR:
+  case PRIM_SIZEOF:
+  case PRIM_TYPEOF:
+    return true;
+
+  default:
+    return false;
   }
-  // add any functions that call the functions added so far
-  forv_Vec(FnSymbol, fn, fnsContainingTaskll) {
-    forv_Vec(CallExpr, call, *fn->calledBy) {
-      if (call->parentSymbol) {
-        FnSymbol* caller = toFnSymbol(call->parentSymbol);
-        INT_ASSERT(caller);
-        fnsContainingTaskll.add_exclusive(caller);
+}
+
+static Expr*
+findHeapVarEscape(Symbol* var, Map<Symbol*,Vec<SymExpr*>*>& useMap) {
+  std::set<Symbol*>    visited;
+  std::vector<Symbol*> worklist;
+
+  visited.insert(var);
+  worklist.push_back(var);
+
+  while (worklist.empty() == false) {
+    Symbol* sym = worklist.back();
+
+    worklist.pop_back();
+
+    for_uses(se, useMap, sym) {
+      CallExpr* call   = toCallExpr(se->parentExpr);
+      Expr*     actual = se;
+      Symbol*   alias  = NULL;
+
+      if (call == NULL)
+        continue;
+
+      if (call->isPrimitive(PRIM_ADDR_OF)         ||
+          call->isPrimitive(PRIM_SET_REFERENCE)   ||
+          call->isPrimitive(PRIM_GET_MEMBER)      ||
+          call->isPrimitive(PRIM_GET_SVEC_MEMBER) ||
+          call->isPrimitive(PRIM_GET_REAL)        ||
+          call->isPrimitive(PRIM_GET_IMAG)) {
+        // The result points into 'sym'; treat it as a use of 'sym'.
+        actual = call;
+        call   = toCallExpr(call->parentExpr);
+
+        if (call == NULL)
+          continue;
       }
+
+      if (call->isPrimitive(PRIM_MOVE) || call->isPrimitive(PRIM_ASSIGN)) {
+        if (actual == call->get(1))
+          continue;
+
+        SymExpr* lhs = toSymExpr(call->get(1));
+
+        if (lhs == NULL || isModuleSymbol(lhs->symbol()->defPoint->parentSymbol))
+          return call;
+
+        alias = lhs->symbol();
+
+      } else if (call->isPrimitive(PRIM_SET_MEMBER) ||
+                 call->isPrimitive(PRIM_SET_SVEC_MEMBER)) {
+        // Storing into a field of 'sym' is fine; storing 'sym' is not.
+        if (actual != call->get(1))
+          return call;
+
+      } else if (call->primitive != NULL) {
+        if (isValueOnlyPrimitive(call) == false)
+          return call;
+
+      } else if (FnSymbol* fn = call->resolvedFunction()) {
+        if (fn->hasFlag(FLAG_BEGIN))
+          return call;
+
+        // C code may keep the address
+        if (fn->hasFlag(FLAG_EXTERN))
+          return call;
+
+        ArgSymbol* formal = actual_to_formal(actual);
+
+        if (mayHoldHeapVarAddress(formal) && visited.count(formal) == 0) {
+          visited.insert(formal);
+          worklist.push_back(formal);
+        }
+
+        // A ref-returning callee may hand the address back.
+        if (fn->retTag == RET_REF) {
+          if (CallExpr* move = toCallExpr(call->parentExpr)) {
+            if (move->isPrimitive(PRIM_MOVE))
+              alias = toSymExpr(move->get(1))->symbol();
+          }
+        }
+
+      } else {
+        // an indirect call, e.g. through a first-class function
+        return call;
+      }
+
+      if (alias != NULL                  &&
+          mayHoldHeapVarAddress(alias)   &&
+          visited.count(alias) == 0) {
+        visited.insert(alias);
+        worklist.push_back(alias);
+      }
+    }
+  }
+
+  return NULL;
+}
+
+static void
+reportHeapVar(Symbol*                     var,
+              std::map<Symbol*, Symbol*>& heapCause,
+              bool                        freed,
+              Expr*                       escape) {
+  ModuleSymbol* mod   = var->getModule();
+  FnSymbol*     fn    = var->defPoint->getFunction();
+  Symbol*       shown = var;
+  Symbol*       root  = var;
+
+  // Name the variable after the user symbol a temp was introduced for
+  while (heapCause.count(root) != 0) {
+    root = heapCause[root];
+
+    if (shown->hasFlag(FLAG_TEMP) && root->defPoint->getFunction() == fn)
+      shown = root;
+  }
+
+  if (developer ||
+      (!shown->hasFlag(FLAG_TEMP) &&
+       mod->modTag != MOD_INTERNAL && mod->modTag != MOD_STANDARD)) {
+    FnSymbol* onFn = toFnSymbol(root->defPoint->parentSymbol);
+
+    printf("%s:%d: heap-allocated %s in %s: ",
+           shown->fname(), shown->linenum(), shown->name, fn->name);
+
+    if (onFn != NULL && onFn->hasFlag(FLAG_ON))
+      printf("referenced by on statement at %s:%d, ",
+             onFn->fname(), onFn->linenum());
+    else
+      printf("referenced remotely, ");
+
+    if (freed) {
+      printf("freed at end of scope\n");
+
+    } else if (escape == NULL) {
+      printf("not freed: defined more than once\n");
+
+    } else {
+      CallExpr* call   = toCallExpr(escape);
+      FnSymbol* callee = (call != NULL) ? call->resolvedFunction() : NULL;
+
+      printf("not freed: may outlive its scope ");
+
+      if (callee != NULL && callee->hasFlag(FLAG_BEGIN))
+        printf("in begin");
+      else if (callee != NULL)
+        printf("via call to %s", callee->name);
+      else if (call != NULL && call->primitive != NULL)
+        printf("via primitive '%s'", call->primitive->name);
+      else
+        printf("via indirect call");
+
+      printf(" at %s:%d\n", escape->fname(), escape->linenum());
     }
   }
+}
 
+static void
+freeHeapAllocatedVars(Vec<Symbol*>                heapAllocatedVars,
+                      std::map<Symbol*, Symbol*>& heapCause) {
   Vec<Symbol*> symSet;
   std::vector<BaseAST*> asts;
   collect_asts(rootModule, asts);
@@ -934,49 +1171,17 @@ freeHeapAllocatedVars(Vec<Symbol*> heapAllocatedVars) {
   buildDefUseMaps(symSet, defMap, useMap);
 
   forv_Vec(Symbol, var, heapAllocatedVars) {
-    // find out if a variable that was put on the heap could be passed in as an
-    // argument to a function created by a begin statement; if not, free the
+    // find out if the address of a variable that was put on the heap could
+    // reach a function created by a begin statement; if not, free the
     // heap memory just allocated at the end of the block
     Vec<SymExpr*>* defs = defMap.get(var);
     if (defs == NULL) {
       INT_FATAL(var, "Symbol is never defined.");
     }
     if (defs->n == 1) {
-      bool freeVar = true;
-      Vec<Symbol*> varsToTrack;
-      varsToTrack.add(var);
-      forv_Vec(Symbol, v, varsToTrack) {
-        if (useMap.get(v)) {
-          forv_Vec(SymExpr, se, *useMap.get(v)) {
-            if (CallExpr* call = toCallExpr(se->parentExpr)) {
-              if (call->isPrimitive(PRIM_ADDR_OF) ||
-                  call->isPrimitive(PRIM_SET_REFERENCE) ||
-                  call->isPrimitive(PRIM_GET_MEMBER) ||
-                  call->isPrimitive(PRIM_GET_MEMBER_VALUE) ||
-                  call->isPrimitive(PRIM_GET_SVEC_MEMBER) ||
-                  // TODO - should this handle PRIM_GET_SVEC_MEMBER_VALUE?
-                  call->isPrimitive(PRIM_WIDE_GET_LOCALE) ||
-                  call->isPrimitive(PRIM_WIDE_GET_NODE)) {
-                // Treat the use of these primitives as a use of their arguments.
-                call = toCallExpr(call->parentExpr);
-              }
-              if (call->isPrimitive(PRIM_MOVE) || call->isPrimitive(PRIM_ASSIGN)) {
-                Symbol* toAdd = toSymExpr(call->get(1))->symbol();
-                // BHARSH TODO: we really want something like a set that we can
-                // modify while iterating over it.
-                if (!varsToTrack.in(toAdd)) {
-                  varsToTrack.add(toAdd);
-                }
-              }
-              else if (fnsContainingTaskll.in(call->resolvedFunction())) {
-                freeVar = false;
-                break;
-              }
-            }
-          }
-          if (!freeVar) break;
-        }
-      }
+      Expr* escape  = findHeapVarEscape(var, useMap);
+      bool  freeVar = (escape == NULL);
+
       if (freeVar) {
         CallExpr* move = toCallExpr(defs->v[0]->parentExpr);
         INT_ASSERT(move && move->isPrimitive(PRIM_MOVE));
@@ -1033,6 +1238,12 @@ freeHeapAllocatedVars(Vec<Symbol*> heapAllocatedVars) {
           block->insertAtTailBeforeFlow(callChplHereFree(move->get(1)->copy()));
         }
       }
+
+      if (fReportHeapVars)
+        reportHeapVar(var, heapCause, freeVar, escape);
+
+    } else if (fReportHeapVars) {
+      reportHeapVar(var, heapCause, false, NULL);
     }
     // else ...
     // TODO: After the new constructor story is implemented, every declaration
@@ -1075,6 +1286,18 @@ needHeapVars() {
   return true;
 }
 
+// Is 'sym' (or what it refers to) a pointer to a Chapel class instance?
+// Instances are always allocated on the heap, so a reference to one of
+// their fields is remotely accessible no matter where 'sym' lives.
+static bool
+isHeapObjectPointer(Symbol* sym) {
+  Type* type = sym->getValType();
+
+  return isClass(type)                              &&
+         !type->symbol->hasFlag(FLAG_EXTERN)        &&
+         !type->symbol->hasFlag(FLAG_DATA_CLASS);
+}
+
 //
 // In the following, through makeHeapAllocations():
 //   refSet, refVec - symbols whose referencees need to be heap-allocated
@@ -1085,13 +1308,14 @@ needHeapVars() {
 // allocation (for its formals), as determined by the comm layer
 // and/or --local setting..
 // Traverses all ref formals of these functions and adds them to the refSet and
-// refVec.
+// refVec.  A ref formal that the on-body never mentions is never dereferenced
+// remotely, so its referent can stay where it is.
 static void findBlockRefActuals(Vec<Symbol*>& refSet, Vec<Symbol*>& refVec)
 {
   forv_Vec(FnSymbol, fn, gFnSymbols) {
     if (fn->hasFlag(FLAG_ON) && !fn->hasFlag(FLAG_LOCAL_ON) && needHeapVars()) {
       for_formals(formal, fn) {
-        if (formal->isRef()) {
+        if (formal->isRef() && formal->firstSymExpr() != NULL) {
           refSet.set_add(formal);
           refVec.add(formal);
         }
@@ -1172,6 +1396,10 @@ makeHeapAllocations() {
   Vec<Symbol*> varSet;
   Vec<Symbol*> varVec;
 
+  // For --report-heap-vars: the symbol whose reference led to each entry
+  // in refVec/varVec.  The chain ends at an on-function formal.
+  std::map<Symbol*, Symbol*> heapCause;
+
   Map<Symbol*,Vec<SymExpr*>*> defMap;
   Map<Symbol*,Vec<SymExpr*>*> useMap;
   buildDefUseMaps(defMap, useMap);
@@ -1202,6 +1430,7 @@ makeHeapAllocations() {
         if (se->symbol()->isRef() && !refSet.set_in(se->symbol())) {
           refSet.set_add(se->symbol());
           refVec.add(se->symbol());
+          heapCause[se->symbol()] = arg;
         }
         // BHARSH TODO: Need to add to varVec here?
       }
@@ -1219,6 +1448,7 @@ makeHeapAllocations() {
                 if (!se->isRef() && !varSet.set_in(se->symbol())) {
                   varSet.set_add(se->symbol());
                   varVec.add(se->symbol());
+                  heapCause[se->symbol()] = var;
                 }
                 // BHARSH TODO: Need to add to refVec here?
               } else if (rhs->isPrimitive(PRIM_GET_MEMBER) ||
@@ -1227,14 +1457,20 @@ makeHeapAllocations() {
                          rhs->isPrimitive(PRIM_GET_SVEC_MEMBER_VALUE)) {
                 SymExpr* se = toSymExpr(rhs->get(1));
                 INT_ASSERT(se);
-                if (se->symbol()->isRef()) {
+                if (isHeapObjectPointer(se->symbol())) {
+                  // The field lives in a class instance, which is already
+                  // on the heap; the variable holding the instance pointer
+                  // can stay where it is.
+                } else if (se->symbol()->isRef()) {
                   if (!refSet.set_in(se->symbol())) {
                     refSet.set_add(se->symbol());
                     refVec.add(se->symbol());
+                    heapCause[se->symbol()] = var;
                   }
                 } else if (!varSet.set_in(se->symbol())) {
                   varSet.set_add(se->symbol());
                   varVec.add(se->symbol());
+                  heapCause[se->symbol()] = var;
                 }
               }
               //
@@ -1258,6 +1494,7 @@ makeHeapAllocations() {
               if (!refSet.set_in(rhs->symbol())) {
                 refSet.set_add(rhs->symbol());
                 refVec.add(rhs->symbol());
+                heapCause[rhs->symbol()] = var;
               }
             } else
               INT_FATAL(ref, "unexpected case");
@@ -1319,6 +1556,7 @@ makeHeapAllocations() {
       VarSymbol* tmp = newTemp(var->type);
       varSet.set_add(tmp);
       varVec.add(tmp);
+      heapCause[tmp] = arg;
       SymExpr* firstDef = new SymExpr(tmp);
       arg->getFunction()->insertAtHead(new CallExpr(PRIM_MOVE, firstDef, arg));
       addDef(defMap, firstDef);
@@ -1454,7 +1692,7 @@ makeHeapAllocations() {
     var->qual = QUAL_VAL;
   }
 
-  freeHeapAllocatedVars(heapAllocatedVars);
+  freeHeapAllocatedVars(heapAllocatedVars, heapCause);
 }
 
 
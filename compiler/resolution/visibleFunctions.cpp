@@ -67,6 +67,43 @@ static Map<BlockStmt*, BlockStmt*>            visibilityBlockCache;
 
 static int                                    nVisibleFunctions       = 0;
 
+/************************************* | **************************************
+*                                                                             *
+* Memoized results of getVisibleFunctions().                                  *
+*                                                                             *
+* The transitive set of candidates for a (name, visibility block) pair is     *
+* the same for every call that asks for it, unless the walk had to consult   *
+* the call itself -- a private function or module, or a renaming 'use'.      *
+* Such walks are not cached.                                                  *
+*                                                                             *
+* An entry records the epoch of its name when it was computed.  Adding a      *
+* visible function (e.g. an instantiation or a wrapper) bumps the epoch for  *
+* that function's name, which invalidates every entry for that name without  *
+* disturbing the others.                                                      *
+*                                                                             *
+************************************** | *************************************/
+
+class VisibleFunctionsMemo {
+public:
+  int                                   epoch;
+  Vec<FnSymbol*>                        fns;
+};
+
+typedef std::pair<BlockStmt*, const char*>              VisibleFunctionsKey;
+typedef std::map<VisibleFunctionsKey,
+                 VisibleFunctionsMemo*>                 VisibleFunctionsMemoMap;
+
+static VisibleFunctionsMemoMap                visibleFunctionsMemo;
+static Map<const char*, int>                  visibleFunctionsEpoch;
+
+// Set by the walk when its result depends on the call being resolved
+static bool                                   walkDependsOnCall       = false;
+
+static unsigned long                          nMemoHits               = 0;
+static unsigned long                          nMemoMisses             = 0;
+static unsigned long                          nMemoStale              = 0;
+static unsigned long                          nMemoUncacheable        = 0;
+
 /************************************* | **************************************
 *                                                                             *
 *                                                                             *
@@ -170,6 +207,8 @@ static void buildVisibleFunctionMap() {
         vfb->visibleFunctions.put(fn->name, fns);
       }
       fns->add(fn);
+
+      visibleFunctionsEpoch.put(fn->name, visibleFunctionsEpoch.get(fn->name) + 1);
     }
   }
   nVisibleFunctions = gFnSymbols.n;
@@ -401,13 +440,105 @@ static BlockStmt* getVisibleFunctions(const char*           name,
                                       std::set<BlockStmt*>& visited,
                                       Vec<FnSymbol*>&       visibleFns);
 
+//
+// Skip the non-module blocks that neither define functions nor use
+// modules, so that every call in e.g. a leaf function body shares the
+// memo entry of the nearest block that contributes candidates.
+//
+// The skipped blocks are entered into visibilityBlockCache just as the
+// walk would have done; a block's instantiation point may later be
+// removed from the tree, after which it can no longer be walked up.
+//
+static BlockStmt* firstContributingBlock(BlockStmt* block) {
+  Vec<BlockStmt*> skipped;
+
+  while (true) {
+    if (standardModuleSet.set_in(block)) {
+      block = theProgram->block;
+    }
+
+    if (block                                == rootModule->block ||
+        isModuleSymbol(block->parentSymbol)  == true              ||
+        visibleFunctionMap.get(block)        != NULL              ||
+        block->useList                       != NULL) {
+      break;
+    }
+
+    if (BlockStmt* next = visibilityBlockCache.get(block)) {
+      block = next;
+    } else {
+      skipped.add(block);
+      block = getVisibilityBlock(block);
+    }
+  }
+
+  forv_Vec(BlockStmt, skip, skipped) {
+    visibilityBlockCache.put(skip, block);
+  }
+
+  return block;
+}
+
 void getVisibleFunctions(const char*      name,
                          CallExpr*        call,
                          Vec<FnSymbol*>&  visibleFns) {
   BlockStmt*           block    = getVisibilityBlock(call);
   std::set<BlockStmt*> visited;
 
+  if (fNoCacheVisibleFunctions == true) {
+    getVisibleFunctions(name, call, block, visited, visibleFns);
+    return;
+  }
+
+  block = firstContributingBlock(block);
+
+  VisibleFunctionsKey   key(block, name);
+  VisibleFunctionsMemo* memo  = NULL;
+  int                   epoch = visibleFunctionsEpoch.get(name);
+  bool                  stale = false;
+
+  VisibleFunctionsMemoMap::iterator it = visibleFunctionsMemo.find(key);
+
+  // Each lookup is counted once: as a hit, as stale if an out-of-date
+  // memo had to be recomputed, or else as uncacheable or a miss.
+  if (it != visibleFunctionsMemo.end()) {
+    memo = it->second;
+
+    if (memo->epoch == epoch) {
+      nMemoHits++;
+      visibleFns.append(memo->fns);
+      return;
+    }
+
+    nMemoStale++;
+    stale = true;
+  }
+
+  int start = visibleFns.n;
+
+  walkDependsOnCall = false;
+
   getVisibleFunctions(name, call, block, visited, visibleFns);
+
+  if (walkDependsOnCall == true) {
+    if (stale == false)
+      nMemoUncacheable++;
+
+  } else {
+    if (memo == NULL) {
+      memo = new VisibleFunctionsMemo();
+      visibleFunctionsMemo[key] = memo;
+    }
+
+    memo->epoch = epoch;
+    memo->fns.clear();
+
+    for (int i = start; i < visibleFns.n; i++)
+      memo->fns.add(visibleFns.v[i]);
+
+    if (stale == false)
+      nMemoMisses++;
+  }
 }
 
 static BlockStmt* getVisibleFunctions(const char*           name,
@@ -439,6 +570,10 @@ static BlockStmt* getVisibleFunctions(const char*           name,
 
       if (Vec<FnSymbol*>* fns = vfb->visibleFunctions.get(name)) {
         forv_Vec(FnSymbol, fn, *fns) {
+          if (fn->hasFlag(FLAG_PRIVATE) == true) {
+            walkDependsOnCall = true;
+          }
+
           if (fn->isVisible(call) == true) {
             // isVisible checks if the function is private to its defining
             // module (and in that case, if we are under its defining module)
@@ -467,8 +602,15 @@ static BlockStmt* getVisibleFunctions(const char*           name,
             // cannot skip if this block uses modules
             canSkipThisBlock = false;
 
+            if (mod->hasFlag(FLAG_PRIVATE) == true) {
+              walkDependsOnCall = true;
+            }
+
             if (mod->isVisible(call) == true) {
               if (use->isARename(name) == true) {
+                // the memo's epochs are per name; don't cache through a rename
+                walkDependsOnCall = true;
+
                 getVisibleFunctions(use->getRename(name),
                                     call,
                                     mod->block,
@@ -595,6 +737,16 @@ void visibleFunctionsClear() {
 
   visibilityBlockCache.clear();
 
+  for (VisibleFunctionsMemoMap::iterator it = visibleFunctionsMemo.begin();
+       it != visibleFunctionsMemo.end();
+       ++it) {
+    delete it->second;
+  }
+
+  visibleFunctionsMemo.clear();
+
+  visibleFunctionsEpoch.clear();
+
   for (std::map<int, SymbolMap*>::iterator it = capturedValues.begin();
        it != capturedValues.end();
        ++it) {
@@ -602,6 +754,23 @@ void visibleFunctionsClear() {
   }
 }
 
+void visibleFunctionsReportCache(FILE* fp) {
+  unsigned long lookups = nMemoHits + nMemoMisses + nMemoStale + nMemoUncacheable;
+
+  if (fNoCacheVisibleFunctions == true || lookups == 0)
+    return;
+
+  fprintf(fp,
+          "\nVisible function cache: %lu lookups, %lu hits (%.1f%%), "
+          "%lu misses, %lu stale, %lu uncacheable\n",
+          lookups,
+          nMemoHits,
+          (100.0 * nMemoHits) / lookups,
+          nMemoMisses,
+          nMemoStale,
+          nMemoUncacheable);
+}
+
 /************************************* | **************************************
 *                                                                             *
 *                                                                             *
@@ -40,6 +40,7 @@
 #include "driver.h"
 #include "expr.h"
 #include "files.h"
+#include "LoopStmt.h"
 #include "mysystem.h"
 #include "passes.h"
 #include "stmt.h"
@@ -2137,6 +2138,10 @@ void makeBinaryLLVM(void) {
   output.os().flush();
 #endif
 
+  // The module has now been through the full optimization pipeline
+  if (fReportVectorizedLoops)
+    LoopStmt::reportVectorizedLoops(info->module);
+
   //finishClang is before the call to the debug finalize
   deleteClang(info);
 
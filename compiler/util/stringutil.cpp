@@ -25,6 +25,7 @@
 
 #include "map.h"
 #include "misc.h"
+#include "timer.h"
 
 #include <algorithm>
 #include <climits>
@@ -32,74 +33,258 @@
 #include <sstream>
 
 #include <inttypes.h>
+#include <vector>
+
+/************************************ | *************************************
+*                                                                           *
+* The interned string table behind astr().                                  *
+*                                                                           *
+* Every canonical string is stored in an arena block, preceded by a small   *
+* header holding its precomputed hash and length:                           *
+*                                                                           *
+*     [ hash | len ][ c h a r s \0 ]                                        *
+*                   ^                                                       *
+*                   pointer returned by astr()                              *
+*                                                                           *
+* The table itself is open addressing with linear probing over an array of  *
+* those pointers.  A probe compares hashes and lengths (both read from the  *
+* header) before touching the characters, and growing the table never       *
+* rehashes a string.                                                        *
+*                                                                           *
+* Lookups do not take a lock.  Inserts are serialized by a spin lock; a new *
+* entry is published with a release store after its characters are in       *
+* place, and a grown table is fully populated before it replaces the old    *
+* one.  Old tables are retired rather than freed so that a reader still     *
+* probing one stays safe.  The compiler front end is single threaded today; *
+* this keeps astr() usable if that changes.                                 *
+*                                                                           *
+************************************* | ************************************/
+
+#if defined(__GNUC__) || defined(__clang__)
+#define ASTR_LOAD(p)      __atomic_load_n(&(p), __ATOMIC_ACQUIRE)
+#define ASTR_STORE(p, v)  __atomic_store_n(&(p), (v), __ATOMIC_RELEASE)
+#define ASTR_LOCK(l)      while (__atomic_test_and_set(&(l), __ATOMIC_ACQUIRE))
+#define ASTR_UNLOCK(l)    __atomic_clear(&(l), __ATOMIC_RELEASE)
+#else
+#define ASTR_LOAD(p)      (p)
+#define ASTR_STORE(p, v)  ((p) = (v))
+#define ASTR_LOCK(l)      ((l) = true)
+#define ASTR_UNLOCK(l)    ((l) = false)
+#endif
+
+struct AstrHeader {
+  uint32_t hash;
+  uint32_t len;
+};
+
+struct AstrTable {
+  size_t       mask;       // number of slots - 1
+  size_t       count;      // number of slots in use
+  const char** slots;
+  AstrTable*   retired;    // previous (smaller) table, kept for readers
+};
+
+static const size_t kAstrInitialSlots = 1 << 14;
+static const size_t kAstrBlockSize    = 64 * 1024;
+
+static AstrTable*  sAstrTable      = NULL;
+static bool        sAstrLock       = false;
+
+static char**      sAstrBlocks     = NULL;   // every arena block, for freeing
+static size_t      sAstrNumBlocks  = 0;
+static size_t      sAstrMaxBlocks  = 0;
+static char*       sAstrBump       = NULL;
+static char*       sAstrEnd        = NULL;
+
+// FNV-1a over the first len bytes of s
+static inline uint32_t astrHash(const char* s, size_t len) {
+  uint32_t h = 2166136261u;
+
+  for (size_t i = 0; i < len; i++) {
+    h ^= (unsigned char) s[i];
+    h *= 16777619u;
+  }
+
+  return h;
+}
+
+static inline const AstrHeader* astrHeader(const char* s) {
+  return ((const AstrHeader*) s) - 1;
+}
+
+static AstrTable* newAstrTable(size_t numSlots) {
+  AstrTable* table = (AstrTable*) malloc(sizeof(AstrTable));
+
+  table->mask    = numSlots - 1;
+  table->count   = 0;
+  table->slots   = (const char**) calloc(numSlots, sizeof(const char*));
+  table->retired = NULL;
+
+  return table;
+}
+
+static char* astrArenaAlloc(size_t size) {
+  size = (size + sizeof(AstrHeader) - 1) & ~(sizeof(AstrHeader) - 1);
+
+  if (sAstrBump == NULL || (size_t) (sAstrEnd - sAstrBump) < size) {
+    size_t blockSize = (size > kAstrBlockSize) ? size : kAstrBlockSize;
+
+    if (sAstrNumBlocks == sAstrMaxBlocks) {
+      sAstrMaxBlocks = (sAstrMaxBlocks == 0) ? 64 : 2 * sAstrMaxBlocks;
+      sAstrBlocks    = (char**) realloc(sAstrBlocks,
+                                        sAstrMaxBlocks * sizeof(char*));
+    }
+
+    char* block = (char*) malloc(blockSize);
+
+    sAstrBlocks[sAstrNumBlocks++] = block;
+
+    // An oversized string gets a block of its own; keep bumping
+    // through the current block for everything else.
+    if (size > kAstrBlockSize)
+      return block;
+
+    sAstrBump = block;
+    sAstrEnd  = block + blockSize;
+  }
+
+  char* retval = sAstrBump;
+
+  sAstrBump += size;
+
+  return retval;
+}
 
-static ChainHashMap<const char*, StringHashFns, const char*> chapelStringsTable;
+// Returns the slot index holding 's' or the empty slot where it belongs
+static inline size_t astrProbe(const char** slots,
+                               size_t       mask,
+                               const char*  s,
+                               size_t       len,
+                               uint32_t     hash) {
+  size_t i = hash & mask;
 
-static const char*
-canonicalize_string(const char *s) {
-  const char* ss = chapelStringsTable.get(s);
-  if (!ss) {
-    chapelStringsTable.put(s, s);
-    return s;
+  while (true) {
+    const char* entry = ASTR_LOAD(slots[i]);
+
+    if (entry == NULL)
+      return i;
+
+    const AstrHeader* hdr = astrHeader(entry);
+
+    if (hdr->hash == hash && hdr->len == len && memcmp(entry, s, len) == 0)
+      return i;
+
+    i = (i + 1) & mask;
+  }
+}
+
+static void growAstrTable() {
+  AstrTable* oldTable = sAstrTable;
+  AstrTable* newTable = newAstrTable(2 * (oldTable->mask + 1));
+
+  for (size_t i = 0; i <= oldTable->mask; i++) {
+    if (const char* entry = oldTable->slots[i]) {
+      size_t j = astrHeader(entry)->hash & newTable->mask;
+
+      while (newTable->slots[j] != NULL)
+        j = (j + 1) & newTable->mask;
+
+      newTable->slots[j] = entry;
+    }
   }
-  return ss;
+
+  newTable->count   = oldTable->count;
+  newTable->retired = oldTable;
+
+  ASTR_STORE(sAstrTable, newTable);
+}
+
+static const char* internString(const char* s, size_t len) {
+  uint32_t   hash  = astrHash(s, len);
+  AstrTable* table = ASTR_LOAD(sAstrTable);
+
+  if (table != NULL) {
+    const char* entry = ASTR_LOAD(table->slots[astrProbe(table->slots,
+                                                         table->mask,
+                                                         s, len, hash)]);
+    if (entry != NULL)
+      return entry;
+  }
+
+  ASTR_LOCK(sAstrLock);
+
+  if (sAstrTable == NULL)
+    sAstrTable = newAstrTable(kAstrInitialSlots);
+
+  // The table may have changed while we waited for the lock
+  table = sAstrTable;
+
+  size_t      i     = astrProbe(table->slots, table->mask, s, len, hash);
+  const char* entry = table->slots[i];
+
+  if (entry == NULL) {
+    char*       mem = astrArenaAlloc(sizeof(AstrHeader) + len + 1);
+    AstrHeader* hdr = (AstrHeader*) mem;
+    char*       str = mem + sizeof(AstrHeader);
+
+    hdr->hash = hash;
+    hdr->len  = (uint32_t) len;
+
+    memcpy(str, s, len);
+    str[len] = '\0';
+
+    ASTR_STORE(table->slots[i], (const char*) str);
+
+    entry = str;
+
+    // keep the load factor at or below 1/2
+    if (2 * ++table->count > table->mask)
+      growAstrTable();
+  }
+
+  ASTR_UNLOCK(sAstrLock);
+
+  return entry;
 }
 
 const char*
 astr(const char* s1, const char* s2, const char* s3, const char* s4,
      const char* s5, const char* s6, const char* s7, const char* s8) {
-  int len;
-  len = strlen(s1);
-  if (s2)
-    len += strlen(s2);
-  if (s3)
-    len += strlen(s3);
-  if (s4)
-    len += strlen(s4);
-  if (s5)
-    len += strlen(s5);
-  if (s6)
-    len += strlen(s6);
-  if (s7)
-    len += strlen(s7);
-  if (s8)
-    len += strlen(s8);
-  char* s = (char*)malloc(len+1);
-  strcpy(s, s1);
-  if (s2)
-    strcat(s, s2);
-  if (s3)
-    strcat(s, s3);
-  if (s4)
-    strcat(s, s4);
-  if (s5)
-    strcat(s, s5);
-  if (s6)
-    strcat(s, s6);
-  if (s7)
-    strcat(s, s7);
-  if (s8)
-    strcat(s, s8);
-  const char* t = canonicalize_string(s);
-  if (s != t)
+  const char* parts[8]  = { s1, s2, s3, s4, s5, s6, s7, s8 };
+  size_t      lens[8];
+  size_t      len       = 0;
+  int         numParts  = 0;
+
+  for (int i = 0; i < 8 && parts[i] != NULL; i++) {
+    lens[i]   = strlen(parts[i]);
+    len      += lens[i];
+    numParts  = i + 1;
+  }
+
+  // Concatenate into a stack buffer when we can; the table copies the
+  // result into its arena only if the string is new.
+  char  buffer[256];
+  char* s   = (len < sizeof(buffer)) ? buffer : (char*) malloc(len + 1);
+  char* pos = s;
+
+  for (int i = 0; i < numParts; i++) {
+    memcpy(pos, parts[i], lens[i]);
+    pos += lens[i];
+  }
+
+  *pos = '\0';
+
+  const char* retval = internString(s, len);
+
+  if (s != buffer)
     free(s);
-  return t;
+
+  return retval;
 }
 
 const char* astr(const char* s1)
 {
-  const char* ss = chapelStringsTable.get(s1);
-  if (ss)
-    // return an existing entry
-    return ss;
-
-  // add a new entry - always a fresh malloc
-  int len;
-  len = strlen(s1);
-  char* s = (char*)malloc(len+1);
-  strcpy(s, s1);
-  chapelStringsTable.put(s,s);
-  return s;
+  return internString(s1, strlen(s1));
 }
 
 const char* astr(const std::string& s)
@@ -121,22 +306,105 @@ istr(int i) {
 // note: e must be in s
 //
 const char* asubstr(const char* s, const char* e) {
-  char* ss = (char*)malloc(e-s+1);
-  strncpy(ss, s, e-s);
-  ss[e-s] = '\0';
-  const char* t = canonicalize_string(ss);
-  if (ss != t)
-    free(ss);
-  return t;
+  return internString(s, e - s);
 }
 
 
+//
+// Microbenchmark for --benchmark-astr.  Times lookups of every string
+// interned so far (after parsing, that's every identifier in the
+// standard and user modules) through astr() and through the
+// ChainHashMap that astr() used to be built on.  The lookups use fresh
+// copies of the strings so neither table can short-circuit on pointer
+// equality.
+//
+void benchmarkAstr(int rounds) {
+  std::vector<const char*> names;
+  std::vector<char*>       copies;
+
+  if (sAstrTable != NULL) {
+    for (size_t i = 0; i <= sAstrTable->mask; i++) {
+      const char* entry = sAstrTable->slots[i];
+
+      // ChainHashMap can't hold the empty string
+      if (entry != NULL && entry[0] != '\0')
+        names.push_back(entry);
+    }
+  }
+
+  for (size_t i = 0; i < names.size(); i++)
+    copies.push_back(strdup(names[i]));
+
+  ChainHashMap<const char*, StringHashFns, const char*> chainTable;
+  Timer                                                 chainBuild;
+  Timer                                                 chainLookup;
+  Timer                                                 astrLookup;
+  size_t                                                misses = 0;
+
+  chainBuild.start();
+
+  for (size_t i = 0; i < copies.size(); i++)
+    chainTable.put(copies[i], copies[i]);
+
+  chainBuild.stop();
+
+  chainLookup.start();
+
+  for (int r = 0; r < rounds; r++) {
+    for (size_t i = 0; i < copies.size(); i++) {
+      if (chainTable.get(copies[i]) == NULL)
+        misses++;
+    }
+  }
+
+  chainLookup.stop();
+
+  astrLookup.start();
+
+  for (int r = 0; r < rounds; r++) {
+    for (size_t i = 0; i < copies.size(); i++) {
+      if (astr(copies[i]) != names[i])
+        misses++;
+    }
+  }
+
+  astrLookup.stop();
+
+  INT_ASSERT(misses == 0);
+
+  printf("astr benchmark: %lu strings, %d rounds\n",
+         (unsigned long) names.size(), rounds);
+  printf("  ChainHashMap build  %10.3f ms\n", chainBuild.elapsedSecs()  * 1e3);
+  printf("  ChainHashMap lookup %10.3f ms\n", chainLookup.elapsedSecs() * 1e3);
+  printf("  astr() lookup       %10.3f ms\n", astrLookup.elapsedSecs()  * 1e3);
+
+  for (size_t i = 0; i < copies.size(); i++)
+    free(copies[i]);
+}
+
 void deleteStrings() {
-  Vec<const char*> keys;
-  chapelStringsTable.get_keys(keys);
-  forv_Vec(const char, key, keys) {
-    free(const_cast<char*>(key));
+  AstrTable* table = sAstrTable;
+
+  while (table != NULL) {
+    AstrTable* retired = table->retired;
+
+    free(table->slots);
+    free(table);
+
+    table = retired;
   }
+
+  for (size_t i = 0; i < sAstrNumBlocks; i++)
+    free(sAstrBlocks[i]);
+
+  free(sAstrBlocks);
+
+  sAstrTable     = NULL;
+  sAstrBlocks    = NULL;
+  sAstrNumBlocks = 0;
+  sAstrMaxBlocks = 0;
+  sAstrBump      = NULL;
+  sAstrEnd       = NULL;
 }
 
 
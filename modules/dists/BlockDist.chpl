@@ -1545,6 +1545,15 @@ proc Block.dsiTargetLocales() {
 proc BlockArr.dsiHasSingleLocalSubdomain() param return true;
 proc BlockDom.dsiHasSingleLocalSubdomain() param return true;
 
+// 1-D Block arrays give each target locale one contiguous block, in
+// target locale order, so Sort's distributed sort can work on them
+
+proc BlockArr.doiCanSortDistributed() param return rank == 1 && !stridable;
+
+proc BlockArr.doiTargetBlock(i: int) {
+  return dom.locDoms[dom.dist.targetLocDom.dim(1).low + i].myBlock;
+}
+
 // returns the current locale's subdomain
 
 proc BlockArr.dsiLocalSubdomain() {
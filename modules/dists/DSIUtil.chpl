@@ -177,6 +177,65 @@ proc _computeBlock(numelems, numblocks, blocknum, wayhi,
   return (blo, bhi);
 }
 
+//
+// helper functions for tiling multi-dimensional blocks
+//
+// _computeTileSize() returns the side of a tile, in indices, given the
+// requested size: 0 disables tiling and -1 picks the largest power of
+// two for which a tile of two 8-byte elements per index (for example a
+// source and a destination array) fits in cacheBytes.  One-dimensional
+// iteration is never tiled.
+//
+proc _computeTileSize(param rank: int, tileSize: int, cacheBytes: int): int {
+  if rank == 1 then
+    return 0;
+  if tileSize >= 0 then
+    return tileSize;
+
+  const elemsPerTile = max(cacheBytes / 16, 1);
+  var side = 1;
+  while (side * 2) ** rank <= elemsPerTile do
+    side *= 2;
+  return side;
+}
+
+//
+// Yield the tiles of 'block', a tuple of unit-stride ranges, in
+// row-major order.  Tiles are tileSize indices on a side, counted from
+// the low bound of each dimension, except at the high edges.  When
+// tileSize is <= 0, or the block fits in one tile, the block itself is
+// yielded.
+//
+iter _tiledBlocks(block, tileSize: int) {
+  param rank = block.size;
+  var numTiles: rank*int;
+  var total = 1;
+
+  if tileSize > 0 then
+    for param d in 1..rank {
+      numTiles(d) = if block(d).length == 0 then 1
+                    else intCeilXDivByY(block(d).length, tileSize);
+      total *= numTiles(d);
+    }
+
+  if total <= 1 {
+    yield block;
+  } else {
+    for t in 0..#total {
+      var tile = block;
+      var rest = t;
+      for param k in 1..rank {
+        param d = rank - k + 1;
+        type idxType = block(d).idxType;
+        const lo = block(d).low + ((rest % numTiles(d)) * tileSize):idxType;
+        tile(d) = lo..min(lo + (tileSize - 1):idxType, block(d).high);
+        rest /= numTiles(d);
+      }
+      yield tile;
+    }
+  }
+}
+
 //
 // naive routine for dividing numLocales into rank factors
 //
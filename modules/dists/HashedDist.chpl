@@ -0,0 +1,786 @@
+/*
+ * Copyright 2004-2017 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+config param debugHashedDist = false;
+
+/*
+This Hashed distribution maps the indices of an associative domain
+to locales by hashing them.
+
+Each locale stores the indices mapped to it, and the elements of any
+array over the domain that correspond to those indices, in an ordinary
+(non-distributed) associative domain and array.  A domain distributed
+this way can therefore hold more indices than fit in the memory of a
+single locale.
+
+The locale an index is mapped to is chosen by a *mapper*: a record with
+a method
+
+  .. code-block:: chapel
+
+    proc indexToLocaleIndex(ind, targetLocales: [] locale): int
+
+that returns the position in ``targetLocales`` of the locale owning
+``ind``.  The default mapper hashes ``ind`` with the same function that
+associative domains use for their own tables and spreads the hash
+values evenly over the target locales.
+
+
+**Example**
+
+The following code declares a domain ``D`` distributed using a Hashed
+distribution, adds some strings to it, and declares an array ``A`` over
+it.  The `forall` loop sets each array element to the ID of the locale
+to which its index is mapped.
+
+  .. code-block:: chapel
+
+    use HashedDist;
+
+    var D: domain(string) dmapped Hashed(idxType=string);
+    D += "one";
+    D += "two";
+    D += "three";
+
+    var A: [D] int;
+    forall a in A do
+      a = a.locale.id;
+
+
+**Constructor Arguments**
+
+The ``Hashed`` class constructor is defined as follows:
+
+  .. code-block:: chapel
+
+    proc Hashed(
+      type idxType,
+      mapper = new DefaultMapper(),
+      targetLocales: [] locale = Locales)
+
+The argument ``idxType`` is the index type of the domains that will be
+distributed.  ``mapper`` selects the locale owning each index, as
+described above, and ``targetLocales`` lists the locales over which
+indices are distributed.
+
+
+**Data-Parallel Iteration**
+
+A `forall` loop over a Hashed-distributed domain or array runs on every
+target locale at once; each locale iterates over the indices and
+elements it owns, in parallel, exactly as for a non-distributed
+associative domain.  Zippering a Hashed-distributed domain with arrays
+declared over it keeps every iteration local.
+
+
+**Bulk Operations**
+
+Adding indices one at a time, or testing their membership one at a
+time, costs a round trip to the owning locale per index.  The domain
+methods ``bulkAdd`` and ``bulkMember`` take an array of indices
+instead; the indices are grouped by owning locale and each group is
+sent to its owner in a single transfer, where the indices are added
+or looked up in parallel.
+
+  .. code-block:: chapel
+
+    var Keys: [1..n] string = ...;
+    D.bulkAdd(Keys);
+    const Present = D.bulkMember(Keys);
+
+
+**Limitations**
+
+Hashed-distributed domains and arrays do not provide the local
+subdomain queries, and iterate in no particular order, like all
+associative domains.
+*/
+class Hashed : BaseDist {
+
+  // GENERICS:
+
+  //
+  // The distribution's index type and domain's global index type
+  //
+  type idxType = int(64);
+
+  //
+  // Chooses the locale owning each index; see DefaultMapper
+  //
+  const mapper;
+
+
+  // STATE:
+
+  //
+  // a domain and array describing the set of target locales to which
+  // the indices are mapped
+  //
+  const targetLocDom: domain(1);
+  const targetLocales: [targetLocDom] locale;
+
+
+  // CONSTRUCTORS:
+
+  proc Hashed(type idxType = int(64),
+              mapper:?t = new DefaultMapper(),
+              targetLocales: [] locale = Locales) {
+    //
+    // 0-base the local capture of the targetLocDom for simplicity
+    // later on
+    //
+    targetLocDom = {0..#targetLocales.numElements};
+    this.targetLocales = targetLocales;
+  }
+
+  //
+  // builds up a privatized (replicated copy)
+  //
+  proc Hashed(type idxType = int(64),
+              mapper,
+              other: Hashed(idxType, mapper.type)) {
+    targetLocDom = other.targetLocDom;
+    targetLocales = other.targetLocales;
+  }
+
+  proc dsiClone() {
+    return new Hashed(idxType, mapper, targetLocales);
+  }
+
+
+  // DISTRIBUTION INTERFACE:
+
+  proc dsiNewAssociativeDom(type domIdxType, param parSafe: bool)
+  where domIdxType != idxType {
+    compilerError("Trying to create a domain whose index type does not match the distribution's");
+  }
+
+  proc dsiNewAssociativeDom(type idxType, param parSafe: bool) {
+    var dom = new HashedDom(parSafe=parSafe, idxType=idxType,
+                            mapperType=mapper.type, dist=this);
+    dom.setup();
+    return dom;
+  }
+
+  proc dsiDisplayRepresentation() {
+    writeln("targetLocDom = ", targetLocDom);
+    writeln("targetLocales = ", for tl in targetLocales do tl.id);
+  }
+
+  proc writeThis(x) {
+    x.writeln("Hashed");
+    x.writeln("-------");
+    x.writeln("distributed using: ", mapper);
+    x.writeln("across locales: ", targetLocales);
+    x.writeln("indexed via: ", targetLocDom);
+  }
+
+  //
+  // convert an index into a locale value
+  //
+  proc dsiIndexToLocale(ind: idxType) {
+    return targetLocales[indexToLocaleIndex(ind)];
+  }
+
+  proc indexToLocaleIndex(ind: idxType) {
+    const locIdx = mapper.indexToLocaleIndex(ind, targetLocales);
+    if boundsChecking then
+      if !targetLocDom.member(locIdx) then
+        halt("mapper provided invalid locale index: ",
+             locIdx,
+             " is not in domain ",
+             targetLocDom);
+    return locIdx;
+  }
+
+  proc dsiTargetLocales() {
+    return targetLocales;
+  }
+
+  proc dsiSupportsPrivatization() param return true;
+
+  proc dsiGetPrivatizeData() return 0;
+
+  proc dsiPrivatize(privatizeData) {
+    return new Hashed(idxType, mapper, this);
+  }
+
+  proc dsiGetReprivatizeData() return 0;
+
+  proc dsiReprivatize(other, reprivatizeData) { }
+}
+
+
+/*
+  The default mapper for :class:`Hashed`.  It maps an index to a locale
+  by mixing the bits of the index's hash and taking the result modulo
+  the number of target locales.
+*/
+record DefaultMapper {
+  // The hash is mixed again so that the indices a locale owns don't all
+  // land in the same part of its local table, which uses the same hash.
+  proc indexToLocaleIndex(ind, targetLocales: [] locale) : int {
+    const hash = chpl__defaultHashWrapper(ind);
+    const mixed = (_gen_key(hash) & max(int)): int;
+    return mixed % targetLocales.domain.size;
+  }
+}
+
+
+//
+// The global domain class
+//
+class HashedDom : BaseAssociativeDom {
+
+  // GENERICS:
+
+  param parSafe: bool;
+  type idxType;
+  type mapperType;
+
+
+  // LINKAGE:
+
+  //
+  // LEFT: a pointer to the parent distribution
+  //
+  const dist: Hashed(idxType, mapperType);
+
+  //
+  // DOWN: an array of local domain class descriptors -- set up in
+  // setup() below
+  //
+  var locDoms: [dist.targetLocDom] LocHashedDom(idxType, parSafe);
+
+
+  // GLOBAL DOMAIN INTERFACE:
+
+  proc dsiMyDist() return dist;
+
+  proc dsiDisplayRepresentation() {
+    for tli in dist.targetLocDom do
+      writeln("locDoms[", tli, "] = ", locDoms[tli]);
+  }
+
+  proc dsiAdd(i: idxType) {
+    return locDoms[dist.indexToLocaleIndex(i)].add(i);
+  }
+
+  proc dsiRemove(i: idxType) {
+    return locDoms[dist.indexToLocaleIndex(i)].remove(i);
+  }
+
+  proc dsiMember(i: idxType) {
+    return locDoms[dist.indexToLocaleIndex(i)].member(i);
+  }
+
+  proc dsiClear() {
+    coforall locDom in locDoms do on locDom {
+      locDom.myInds.clear();
+    }
+  }
+
+  //
+  // Each locale gets its share of the requested capacity, assuming the
+  // mapper spreads indices evenly.
+  //
+  proc dsiRequestCapacity(numKeys: int) {
+    const perLocale = divceil(numKeys, dist.targetLocDom.numIndices);
+    coforall locDom in locDoms do on locDom {
+      locDom.myInds.requestCapacity(perLocale);
+    }
+  }
+
+  proc dsiNumIndices {
+    var numIndices = 0;
+    for locDom in locDoms do
+      numIndices += locDom.myInds.numIndices;
+    return numIndices;
+  }
+
+  //
+  // Adds the indices in inds to the domain, sending each locale all
+  // of its indices at once.  Returns the number of indices added.
+  //
+  proc dsiBulkAdd(inds: [] idxType, dataSorted=false, isUnique=false,
+                  preserveInds=true) {
+    const (byLocale, starts, counts, _) = _groupByLocale(inds);
+    var numAdded: [dist.targetLocDom] int;
+
+    coforall localeIdx in dist.targetLocDom do on locDoms[localeIdx] {
+      const locDom = locDoms[localeIdx];
+      const mySpan = starts[localeIdx]..#counts[localeIdx];
+      var myInds: [mySpan] idxType;
+      myInds = byLocale[mySpan];
+
+      var myAdded = 0;
+      if parSafe {
+        forall i in myInds with (+ reduce myAdded) do
+          myAdded += locDom.myInds.add(i);
+      } else {
+        for i in myInds do
+          myAdded += locDom.myInds.add(i);
+      }
+      numAdded[localeIdx] = myAdded;
+    }
+
+    return + reduce numAdded;
+  }
+
+  //
+  // Returns an array over inds.domain that is true where the index in
+  // inds is a member of the domain.  As with dsiBulkAdd, each locale is
+  // sent all of the indices it owns at once.
+  //
+  proc dsiBulkMember(inds: [] idxType) {
+    const (byLocale, starts, counts, positions) = _groupByLocale(inds);
+    var memberByLocale: [byLocale.domain] bool;
+
+    coforall localeIdx in dist.targetLocDom do on locDoms[localeIdx] {
+      const locDom = locDoms[localeIdx];
+      const mySpan = starts[localeIdx]..#counts[localeIdx];
+      var myInds: [mySpan] idxType;
+      var myMember: [mySpan] bool;
+      myInds = byLocale[mySpan];
+
+      forall (i, m) in zip(myInds, myMember) do
+        m = locDom.myInds.member(i);
+
+      memberByLocale[mySpan] = myMember;
+    }
+
+    var member: [inds.domain] bool;
+    forall (pos, m) in zip(positions, memberByLocale) do
+      member[pos] = m;
+    return member;
+  }
+
+  //
+  // Sorts the indices in inds by the locale owning them.  Returns the
+  // sorted indices, where each locale's indices start in them and how
+  // many there are, and the position in inds of each sorted index.
+  //
+  proc _groupByLocale(inds: [] idxType) {
+    const owners: [inds.domain] int =
+      [i in inds] dist.indexToLocaleIndex(i);
+
+    var counts: [dist.targetLocDom] int;
+    for o in owners do
+      counts[o] += 1;
+
+    var starts: [dist.targetLocDom] int;
+    for localeIdx in dist.targetLocDom.low+1..dist.targetLocDom.high do
+      starts[localeIdx] = starts[localeIdx-1] + counts[localeIdx-1];
+
+    var byLocale: [0..#inds.numElements] idxType;
+    var positions: [0..#inds.numElements] inds.domain.idxType;
+    var next = starts;
+    for (i, pos, o) in zip(inds, inds.domain, owners) {
+      byLocale[next[o]] = i;
+      positions[next[o]] = pos;
+      next[o] += 1;
+    }
+
+    return (byLocale, starts, counts, positions);
+  }
+
+  iter dsiSorted(comparator) {
+    use Sort;
+    // Gathers all of the indices onto this locale, so this is only
+    // suitable for domains that fit in one locale's memory.
+    var tableCopy: [0..#dsiNumIndices] idxType;
+
+    var next = 0;
+    for locDom in locDoms {
+      for i in locDom.myInds {
+        tableCopy[next] = i;
+        next += 1;
+      }
+    }
+
+    sort(tableCopy, comparator);
+
+    for i in tableCopy do
+      yield i;
+  }
+
+  iter dsiIndsIterSafeForRemoving() {
+    for locDom in locDoms do
+      for i in locDom.myInds._value.dsiIndsIterSafeForRemoving() do
+        yield i;
+  }
+
+  //
+  // the iterator for the domain -- sequential version
+  //
+  // Associative domains define no order of iteration, so it is fine to
+  // visit the indices locale by locale.
+  //
+  iter these() {
+    for locDom in locDoms do
+      for i in locDom.myInds do
+        yield i;
+  }
+
+  //
+  // The parallel iterators run on every locale at once and forward to
+  // the local associative domain's iterators there.  Leaders yield the
+  // local followThis along with the locale's index, so that followers
+  // know which locale's domain or array to resume in.
+  //
+  iter these(param tag: iterKind) where tag == iterKind.leader {
+    coforall localeIdx in dist.targetLocDom do on locDoms[localeIdx] {
+      for followThis in locDoms[localeIdx].myInds._value.these(tag) do
+        yield (followThis, localeIdx);
+    }
+  }
+
+  iter these(param tag: iterKind, followThis) where tag == iterKind.follower {
+    const (locFollowThis, localeIdx) = followThis;
+
+    for i in locDoms[localeIdx].myInds._value.these(tag, locFollowThis) do
+      yield i;
+  }
+
+  iter these(param tag: iterKind) where tag == iterKind.standalone {
+    coforall locDom in locDoms do on locDom {
+      for i in locDom.myInds._value.these(tag) do
+        yield i;
+    }
+  }
+
+  proc dsiSerialWrite(f) {
+    var first = true;
+    f <~> new ioLiteral("{");
+    for i in this {
+      if first then
+        first = false;
+      else
+        f <~> new ioLiteral(", ");
+      f <~> i;
+    }
+    f <~> new ioLiteral("}");
+  }
+
+  proc dsiBuildArray(type eltType) {
+    var arr = new HashedArr(eltType=eltType, idxType=idxType,
+                            mapperType=mapperType, parSafe=parSafe,
+                            dom=this);
+    arr.setup();
+    return arr;
+  }
+
+  proc dsiTargetLocales() {
+    return dist.targetLocales;
+  }
+
+  proc setup() {
+    coforall localeIdx in dist.targetLocDom do
+      on dist.targetLocales[localeIdx] do
+        locDoms[localeIdx] = new LocHashedDom(idxType, parSafe);
+
+    if debugHashedDist then
+      for localeIdx in dist.targetLocDom do
+        writeln(localeIdx, " owns ", locDoms[localeIdx]);
+  }
+
+  proc dsiDestroyDom() {
+    coforall locDom in locDoms do
+      on locDom do
+        delete locDom;
+  }
+
+  proc dsiSupportsPrivatization() param return true;
+
+  proc dsiGetPrivatizeData() return dist.pid;
+
+  proc dsiPrivatize(privatizeData) {
+    var privdist = chpl_getPrivatizedCopy(dist.type, privatizeData);
+    var c = new HashedDom(parSafe=parSafe, idxType=idxType,
+                          mapperType=mapperType, dist=privdist);
+    c.locDoms = locDoms;
+    return c;
+  }
+
+  proc dsiGetReprivatizeData() return 0;
+
+  proc dsiReprivatize(other, reprivatizeData) {
+    locDoms = other.locDoms;
+  }
+}
+
+
+//
+// the local domain class
+//
+class LocHashedDom {
+  type idxType;
+  param parSafe: bool;
+
+  //
+  // the indices mapped to this locale
+  //
+  var myInds: domain(idxType, parSafe=parSafe);
+
+  //
+  // The methods below copy the index to this locale before using it:
+  // associative domains hash and compare indices like strings by
+  // reading their contents from local memory.
+  //
+  proc add(i: idxType) {
+    var retval = 0;
+    on this {
+      const localI = i;
+      retval = myInds.add(localI);
+    }
+    return retval;
+  }
+
+  proc remove(i: idxType) {
+    var retval = 0;
+    on this {
+      const localI = i;
+      retval = myInds.remove(localI);
+    }
+    return retval;
+  }
+
+  proc member(i: idxType) {
+    var retval = false;
+    on this {
+      const localI = i;
+      retval = myInds.member(localI);
+    }
+    return retval;
+  }
+
+  //
+  // Returns the slot holding i in this locale's table, or halts if
+  // there is none.
+  //
+  proc slotOf(i: idxType) {
+    var slot = -1;
+    on this {
+      const localI = i;
+      const (found, foundSlot) = myInds._value._findFilledSlot(localI);
+      if found then
+        slot = foundSlot;
+    }
+    if slot == -1 then
+      halt("array index out of bounds: ", i);
+    return slot;
+  }
+
+  proc writeThis(x) {
+    x.write(myInds);
+  }
+}
+
+
+//
+// the global array class
+//
+class HashedArr : BaseArr {
+
+  // GENERICS:
+
+  type eltType;
+  type idxType;
+  type mapperType;
+  param parSafe: bool;
+
+
+  // LINKAGE:
+
+  //
+  // LEFT: the global domain descriptor for this array
+  //
+  var dom: HashedDom(parSafe, idxType, mapperType);
+
+  //
+  // DOWN: an array of local array classes
+  //
+  var locArrs: [dom.dist.targetLocDom] LocHashedArr(eltType, idxType, parSafe);
+
+  //
+  // optimized reference to a local LocHashedArr instance (or nil)
+  //
+  var myLocArr: LocHashedArr(eltType, idxType, parSafe);
+
+  proc dsiGetBaseDom() return dom;
+
+  proc setup() {
+    var thisid = this.locale.id;
+    coforall localeIdx in dom.dist.targetLocDom do
+      on dom.dist.targetLocales[localeIdx] {
+        locArrs[localeIdx] = new LocHashedArr(eltType, idxType, parSafe,
+                                              dom.locDoms[localeIdx]);
+        if thisid == here.id then
+          myLocArr = locArrs[localeIdx];
+      }
+  }
+
+  proc dsiDestroyArr(isslice:bool) {
+    coforall locArr in locArrs do
+      on locArr do
+        delete locArr;
+  }
+
+
+  // GLOBAL ARRAY INTERFACE:
+
+  //
+  // Elements on other locales are looked up there, in one round trip,
+  // rather than by probing their table from here.
+  //
+  proc dsiAccess(i: idxType) ref {
+    const locArr = locArrs[dom.dist.indexToLocaleIndex(i)];
+    if locArr == myLocArr then
+      local {
+        return locArr.myElems[i];
+      }
+    return locArr.myElems._value.data[locArr.locDom.slotOf(i)];
+  }
+
+  proc dsiAccess(i: idxType)
+  where shouldReturnRvalueByValue(eltType) {
+    const locArr = locArrs[dom.dist.indexToLocaleIndex(i)];
+    if locArr == myLocArr then
+      local {
+        return locArr.myElems[i];
+      }
+    return locArr.myElems._value.data[locArr.locDom.slotOf(i)];
+  }
+
+  proc dsiAccess(i: idxType) const ref
+  where shouldReturnRvalueByConstRef(eltType) {
+    const locArr = locArrs[dom.dist.indexToLocaleIndex(i)];
+    if locArr == myLocArr then
+      local {
+        return locArr.myElems[i];
+      }
+    return locArr.myElems._value.data[locArr.locDom.slotOf(i)];
+  }
+
+  iter these() ref {
+    for locArr in locArrs do
+      for elem in locArr.myElems do
+        yield elem;
+  }
+
+  //
+  // see the HashedDom parallel iterators for the approach
+  //
+  iter these(param tag: iterKind) where tag == iterKind.leader {
+    for followThis in dom.these(tag) do
+      yield followThis;
+  }
+
+  iter these(param tag: iterKind, followThis) ref where tag == iterKind.follower {
+    const (locFollowThis, localeIdx) = followThis;
+
+    for elem in locArrs[localeIdx].myElems._value.these(tag, locFollowThis) do
+      yield elem;
+  }
+
+  iter these(param tag: iterKind) ref where tag == iterKind.standalone {
+    coforall locArr in locArrs do on locArr {
+      for elem in locArr.myElems._value.these(tag) do
+        yield elem;
+    }
+  }
+
+  iter dsiSorted(comparator) {
+    use Sort;
+    // Gathers all of the elements onto this locale; see HashedDom.dsiSorted
+    var tableCopy: [0..#dom.dsiNumIndices] eltType;
+
+    var next = 0;
+    for elem in this {
+      tableCopy[next] = elem;
+      next += 1;
+    }
+
+    sort(tableCopy, comparator);
+
+    for elem in tableCopy do
+      yield elem;
+  }
+
+  proc dsiSerialWrite(f) {
+    var first = true;
+    for elem in this {
+      if first then
+        first = false;
+      else
+        f <~> new ioLiteral(" ");
+      f <~> elem;
+    }
+  }
+
+  proc dsiDisplayRepresentation() {
+    for tli in dom.dist.targetLocDom do
+      writeln("locArrs[", tli, "] = ", locArrs[tli]);
+  }
+
+  proc dsiTargetLocales() {
+    return dom.dist.targetLocales;
+  }
+
+  proc dsiSupportsPrivatization() param return true;
+
+  proc dsiGetPrivatizeData() return dom.pid;
+
+  proc dsiPrivatize(privatizeData) {
+    var privdom = chpl_getPrivatizedCopy(dom.type, privatizeData);
+    var c = new HashedArr(eltType=eltType, idxType=idxType,
+                          mapperType=mapperType, parSafe=parSafe,
+                          dom=privdom);
+    for localeIdx in c.dom.dist.targetLocDom {
+      c.locArrs[localeIdx] = locArrs[localeIdx];
+      if c.locArrs[localeIdx].locale.id == here.id then
+        c.myLocArr = c.locArrs[localeIdx];
+    }
+    return c;
+  }
+}
+
+
+//
+// the local array class
+//
+class LocHashedArr {
+  type eltType;
+  type idxType;
+  param parSafe: bool;
+
+  //
+  // LEFT: the local domain class for this array and locale
+  //
+  const locDom: LocHashedDom(idxType, parSafe);
+
+  //
+  // the elements for the indices mapped to this locale
+  //
+  var myElems: [locDom.myInds] eltType;
+
+  proc writeThis(x) {
+    x.write(myElems);
+  }
+}
@@ -1283,7 +1283,7 @@ module ChapelArray {
 
     pragma "no doc"
     proc bulkAdd(inds: [] _value.idxType, dataSorted=false,
-        isUnique=false, preserveInds=true) where isSparseDom(this) && _value.rank==1 {
+        isUnique=false, preserveInds=true) where isSparseDom(this) && rank==1 {
 
       if inds.size == 0 then return 0;
 
@@ -1300,11 +1300,18 @@ module ChapelArray {
        some cases, expensive operations can be avoided by setting those flags.
        To do so, ``bulkAdd`` must be called explicitly (instead of ``+=``).
 
+       For associative domains, this method adds the indices in ``inds``
+       in fewer operations than adding them one at a time where the
+       domain's distribution supports it, e.g. by sending each locale of
+       a :mod:`HashedDist` domain all of its indices at once.  The flags
+       are ignored.
+
        .. note::
 
-         Right now, this method and the corresponding ``+=`` operator are
-         only available for sparse domains. In the future, we expect that
-         these methods will be available for all irregular domains.
+         Right now, this method is only available for sparse and
+         associative domains, and the corresponding ``+=`` operator only
+         for sparse domains. In the future, we expect that these methods
+         will be available for all irregular domains.
 
        :arg inds: Indices to be added. ``inds`` can be an array of
                   ``rank*idxType`` or an array of ``idxType`` for
@@ -1322,14 +1329,30 @@ module ChapelArray {
        :returns: Number of indices added to the domain
        :rtype: int
     */
-    proc bulkAdd(inds: [] _value.rank*_value.idxType, dataSorted=false,
-        isUnique=false, preserveInds=true) where isSparseDom(this) && _value.rank>1 {
+    proc bulkAdd(inds: [] rank*_value.idxType, dataSorted=false,
+        isUnique=false, preserveInds=true) where isSparseDom(this) && rank>1 {
 
       if inds.size == 0 then return 0;
 
       return _value.dsiBulkAdd(inds, dataSorted, isUnique, preserveInds);
     }
 
+    pragma "no doc"
+    proc bulkAdd(inds: [] _value.idxType, dataSorted=false,
+        isUnique=false, preserveInds=true) where isAssociativeDom(this) {
+
+      if inds.size == 0 then return 0;
+
+      use Reflection;
+      if canResolveMethod(_value, "dsiBulkAdd", inds) then
+        return _value.dsiBulkAdd(inds, dataSorted, isUnique, preserveInds);
+
+      var numAdded = 0;
+      for i in inds do
+        numAdded += add(i);
+      return numAdded;
+    }
+
     /* Remove index ``i`` from this domain */
     proc remove(i) {
       return _value.dsiRemove(i);
@@ -1386,6 +1409,28 @@ module ChapelArray {
       return member(i);
     }
 
+    /* Return an array over ``inds.domain`` that is true where the
+       corresponding index in ``inds`` is a member of this domain.
+
+       Currently only applies to associative domains.  Where the domain's
+       distribution supports it, e.g. :mod:`HashedDist`, all of the
+       indices are looked up in fewer operations than calling
+       :proc:`member` on each of them.
+     */
+    proc bulkMember(inds: [] _value.idxType) {
+      if !isAssociativeDom(this) then
+        compilerError("domain.bulkMember only applies to associative domains");
+
+      use Reflection;
+      if canResolveMethod(_value, "dsiBulkMember", inds) then
+        return _value.dsiBulkMember(inds);
+
+      var isMember: [inds.domain] bool;
+      forall (i, m) in zip(inds, isMember) do
+        m = member(i);
+      return isMember;
+    }
+
     pragma "no doc"
     pragma "reference to const when const this"
     pragma "new alias fn"
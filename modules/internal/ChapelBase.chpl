@@ -972,6 +972,149 @@ module ChapelBase {
     _waitEndCount(e, countRunningTasks);
   }
 
+  //
+  // Combining end counts for coforall+on loops.
+  //
+  // Every task of a coforall+on decrements the loop's end count, which
+  // lives on the originating locale, so a loop that sends many tasks to
+  // each locale funnels one network atomic (or active message) per task
+  // into a single word.  When a bounded coforall+on has more than
+  // endCountCombineRatio tasks per locale, each locale instead gets an
+  // _CoforallLeaf.  Tasks decrement the leaf on their own locale, and
+  // once the initiating task has told a leaf how many tasks to expect,
+  // the last of them forwards all of their completions to the root end
+  // count at once.  Completion traffic to the origin is then
+  // O(numLocales) messages regardless of the number of tasks.
+  //
+  // Setting up and flushing the leaves costs two extra coforall-on
+  // rounds, which only pays off once the origin is flooded by
+  // completions from many locales, so loops keep the flat end count
+  // unless they run on more than endCountCombineCrossover locales.  Run
+  // test/parallel/coforall/endCount/combiningEndCount-perf.chpl on the
+  // target system to find its crossover.
+  //
+  // Note that these class names must not contain "_EndCount"; the
+  // compiler recognizes end count task arguments by that substring.
+  //
+  config param endCountCombineRatio = 16;
+  config const endCountCombineCrossover = 8;
+
+  pragma "no default functions"
+  class _CoforallLeaf {
+    var root: _remoteEndCountType;
+    var pending: chpl__processorAtomicType(int);
+    var expected: int;
+  }
+
+  // Bookkeeping kept by the initiating task: one leaf per locale, and
+  // how many of the loop's tasks have been sent to each.
+  pragma "no default functions"
+  class _CoforallLeaves {
+    var leaves: _ddata(_CoforallLeaf);
+    var expected: _ddata(int);
+  }
+
+  // This function is called once by the initiating task of a bounded
+  // coforall+on, after _upEndCount().  It returns nil when combining is
+  // not worthwhile, in which case tasks decrement 'e' directly.
+  pragma "dont disable remote value forwarding"
+  proc _endCountLeavesAlloc(e: _remoteEndCountType, numTasks): _CoforallLeaves {
+    // The ratio is at least one so that the coforalls below, which have
+    // exactly numLocales tasks, never combine themselves.
+    param ratio = if endCountCombineRatio < 1 then 1 else endCountCombineRatio;
+    var ret: _CoforallLeaves = nil;
+
+    if numLocales > 1 && numLocales > endCountCombineCrossover &&
+       numTasks:int > ratio * numLocales {
+      const leaves   = _ddata_allocate(_CoforallLeaf, numLocales),
+            expected = _ddata_allocate(int, numLocales);
+
+      coforall locIdx in 0..#numLocales do
+        on __primitive("chpl_on_locale_num",
+                       chpl_buildLocaleID(locIdx:chpl_nodeID_t,
+                                          c_sublocid_any)) do
+          leaves[locIdx] = new _CoforallLeaf(root=e);
+
+      ret = new _CoforallLeaves(leaves, expected);
+    }
+
+    return ret;
+  }
+
+  // This function is called by the initiating task for each task of the
+  // loop, before it is started, with the locale the task will run on.
+  // It returns the leaf that task should decrement (nil if none).
+  pragma "dont disable remote value forwarding"
+  inline proc _endCountLeafFor(l: _CoforallLeaves,
+                               target: chpl_localeID_t): _CoforallLeaf {
+    var ret: _CoforallLeaf = nil;
+
+    if l != nil {
+      const node = chpl_nodeFromLocaleID(target);
+
+      l.expected[node] += 1;
+      ret = l.leaves[node];
+    }
+
+    return ret;
+  }
+
+  // This function is called once by the initiating task after all of
+  // the loop's tasks have been started and before _waitEndCount().  It
+  // tells every leaf how many tasks to expect and releases the
+  // bookkeeping; the leaves release themselves.
+  pragma "dont disable remote value forwarding"
+  proc _endCountLeavesFlush(l: _CoforallLeaves) {
+    if l == nil then return;
+
+    const leaves = l.leaves, expected = l.expected;
+
+    coforall locIdx in 0..#numLocales do
+      on __primitive("chpl_on_locale_num",
+                     chpl_buildLocaleID(locIdx:chpl_nodeID_t,
+                                        c_sublocid_any)) do
+        _endCountLeafExpect(leaves[locIdx], expected[locIdx]);
+
+    _ddata_free(leaves, numLocales);
+    _ddata_free(expected, numLocales);
+    delete l;
+  }
+
+  // 'pending' starts at zero, each finished task subtracts one and the
+  // initiating task adds the number of tasks to expect.  Whichever of
+  // these brings it back to zero is the last to touch the leaf.
+  proc _endCountLeafExpect(leaf: _CoforallLeaf, n: int) {
+    leaf.expected = n;
+
+    if leaf.pending.fetchAdd(n, memory_order_acq_rel) + n == 0 then
+      _endCountLeafForward(leaf);
+  }
+
+  proc _endCountLeafForward(leaf: _CoforallLeaf) {
+    const root = leaf.root, n = leaf.expected;
+
+    delete leaf;
+
+    if n > 0 then
+      root.i.sub(n, memory_order_release);
+  }
+
+  // This function is called once by each task of a coforall+on that may
+  // have been given a leaf.
+  pragma "dont disable remote value forwarding"
+  proc _downEndCount(e: _EndCount, leaf: _CoforallLeaf) {
+    if leaf == nil {
+      _downEndCount(e);
+    } else {
+      // The leaf is local, so make this task's remote puts visible
+      // before they are reported as complete.
+      chpl_rmem_consist_fence(memory_order_release);
+
+      if leaf.pending.fetchSub(1, memory_order_acq_rel) - 1 == 0 then
+        _endCountLeafForward(leaf);
+    }
+  }
+
   pragma "command line setting"
   proc _command_line_cast(param s: c_string, type t, x) return _cast(t, x:string);
 
@@ -740,6 +740,17 @@ module ChapelDistribution {
     proc isDefaultRectangular() param return false;
     proc dsiSupportsBulkTransferInterface() param return false;
     proc doiCanBulkTransferStride(viewDom) param return false;
+
+    // Can Sort's sort() sort this array one locale-owned block at a time?
+    // Requires a 1-D array whose locales each own one contiguous range of
+    // indices, ordered the same way as dsiTargetLocales().
+    proc doiCanSortDistributed() param return false;
+
+    // The indices owned by the i-th (0-based) of dsiTargetLocales(), which
+    // may list the same locale more than once.
+    proc doiTargetBlock(i: int) {
+      halt("This array type does not support distributed sorting.");
+    }
   }
 
   /*
@@ -647,6 +647,22 @@ module ChapelLocale {
     return blockedTasks;
   }
 
+  pragma "no doc"
+  proc locale.syncSpinWaits() {
+    var syncSpinWaits: int;
+    extern proc chpl_task_getNumSyncSpinWaits() : uint(64);
+    on this do syncSpinWaits = chpl_task_getNumSyncSpinWaits():int;
+    return syncSpinWaits;
+  }
+
+  pragma "no doc"
+  proc locale.syncParks() {
+    var syncParks: int;
+    extern proc chpl_task_getNumSyncParks() : uint(64);
+    on this do syncParks = chpl_task_getNumSyncParks():int;
+    return syncParks;
+  }
+
 //########################################################################}
 
   //
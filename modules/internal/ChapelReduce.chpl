@@ -38,11 +38,31 @@ module ChapelReduce {
     delete op;
   }
 
+  //
+  // Each task of a forall or coforall with a reduce intent accumulates
+  // into its own op and then combines it into its parent's op.  Since
+  // the parent of a task started by a distributed leader is the op of
+  // the task that forked onto its locale, results are combined per
+  // locale first and then across locales.
+  //
+  // Built-in operators whose state is a single value of a type with
+  // processor atomics provide combineValue(), which updates the parent
+  // with an atomic operation instead of under its lock.  The local
+  // result, including whatever its own children combined into it, is
+  // generated before moving to the parent's locale, so that the
+  // combine is a single fork carrying the value.
+  //
   proc chpl__reduceCombine(globalOp, localOp) {
-    on globalOp {
-      globalOp.lock();
-      globalOp.combine(localOp);
-      globalOp.unlock();
+    if __primitive("method call resolves", globalOp, "combineValue",
+                   localOp.value) {
+      const value = localOp.generate();
+      on globalOp do globalOp.combineValue(value);
+    } else {
+      on globalOp {
+        globalOp.lock();
+        globalOp.combine(localOp);
+        globalOp.unlock();
+      }
     }
   }
 
@@ -65,6 +85,20 @@ module ChapelReduce {
     }
   }
 
+  // Is 'combineValue()' available for an op whose state has type 't'?
+  proc chpl__reduceLockFree(type t) param
+    return t == bool || isIntegralType(t) || isRealType(t);
+
+  // The type of the atomic that combineValue() updates, when the op
+  // provides it for 't'.  Otherwise the field is void, which takes no
+  // space.
+  proc chpl__reduceAtomicType(type t, param used: bool) type {
+    if used then
+      return chpl__processorAtomicType(t);
+    else
+      return void;
+  }
+
   pragma "ReduceScanOp"
   class ReduceScanOp {
     var l: atomicbool; // only accessed locally
@@ -88,11 +122,24 @@ module ChapelReduce {
   class SumReduceScanOp: ReduceScanOp {
     type eltType;
     var value: chpl__sumType(eltType);
+    var combined:
+      chpl__reduceAtomicType(chpl__sumType(eltType),
+                             chpl__reduceLockFree(chpl__sumType(eltType)));
 
-    // Rely on the default value of the desired type.
+    // Real sums start from -0.0, the only value that leaves every
+    // addend, -0.0 included, unchanged.
+    proc initialize() {
+      if isRealType(chpl__sumType(eltType)) {
+        value = identity;
+        combined.write(identity, memory_order_relaxed);
+      }
+    }
+    // Otherwise rely on the default value of the desired type.
     // Todo: is this efficient when that is an array?
     proc identity {
-      var x: chpl__sumType(eltType); return x;
+      var x: chpl__sumType(eltType);
+      if isRealType(x.type) then x = -0.0:x.type;
+      return x;
     }
     proc accumulate(x) {
       value += x;
@@ -103,14 +150,27 @@ module ChapelReduce {
     proc combine(x) {
       value += x.value;
     }
-    proc generate() return value;
+    proc combineValue(x) where chpl__reduceLockFree(chpl__sumType(eltType)) {
+      combined.add(x, memory_order_relaxed);
+    }
+    proc generate() {
+      if chpl__reduceLockFree(chpl__sumType(eltType)) then
+        return value + combined.read(memory_order_relaxed);
+      else
+        return value;
+    }
     proc clone() return new SumReduceScanOp(eltType=eltType);
   }
 
   class ProductReduceScanOp: ReduceScanOp {
     type eltType;
     var value = _prod_id(eltType);
+    var combined: chpl__reduceAtomicType(eltType, chpl__reduceLockFree(eltType));
 
+    proc initialize() {
+      if chpl__reduceLockFree(eltType) then
+        combined.write(identity, memory_order_relaxed);
+    }
     proc identity return _prod_id(eltType);
     proc accumulate(x) {
       value *= x;
@@ -121,14 +181,29 @@ module ChapelReduce {
     proc combine(x) {
       value *= x.value;
     }
-    proc generate() return value;
+    proc combineValue(x) where chpl__reduceLockFree(eltType) {
+      var old = combined.read(memory_order_relaxed);
+      while !combined.compareExchangeWeak(old, old * x, memory_order_relaxed) do
+        old = combined.read(memory_order_relaxed);
+    }
+    proc generate() {
+      if chpl__reduceLockFree(eltType) then
+        return value * combined.read(memory_order_relaxed);
+      else
+        return value;
+    }
     proc clone() return new ProductReduceScanOp(eltType=eltType);
   }
 
   class MaxReduceScanOp: ReduceScanOp {
     type eltType;
     var value = min(eltType);
+    var combined: chpl__reduceAtomicType(eltType, chpl__reduceLockFree(eltType));
 
+    proc initialize() {
+      if chpl__reduceLockFree(eltType) then
+        combined.write(identity, memory_order_relaxed);
+    }
     proc identity return min(eltType);
     proc accumulate(x) {
       value = max(x, value);
@@ -139,14 +214,30 @@ module ChapelReduce {
     proc combine(x) {
       value = max(value, x.value);
     }
-    proc generate() return value;
+    proc combineValue(x) where chpl__reduceLockFree(eltType) {
+      var old = combined.read(memory_order_relaxed);
+      while x > old &&
+            !combined.compareExchangeWeak(old, x, memory_order_relaxed) do
+        old = combined.read(memory_order_relaxed);
+    }
+    proc generate() {
+      if chpl__reduceLockFree(eltType) then
+        return max(value, combined.read(memory_order_relaxed));
+      else
+        return value;
+    }
     proc clone() return new MaxReduceScanOp(eltType=eltType);
   }
 
   class MinReduceScanOp: ReduceScanOp {
     type eltType;
     var value = max(eltType);
+    var combined: chpl__reduceAtomicType(eltType, chpl__reduceLockFree(eltType));
 
+    proc initialize() {
+      if chpl__reduceLockFree(eltType) then
+        combined.write(identity, memory_order_relaxed);
+    }
     proc identity return max(eltType);
     proc accumulate(x) {
       value = min(x, value);
@@ -157,14 +248,30 @@ module ChapelReduce {
     proc combine(x) {
       value = min(value, x.value);
     }
-    proc generate() return value;
+    proc combineValue(x) where chpl__reduceLockFree(eltType) {
+      var old = combined.read(memory_order_relaxed);
+      while x < old &&
+            !combined.compareExchangeWeak(old, x, memory_order_relaxed) do
+        old = combined.read(memory_order_relaxed);
+    }
+    proc generate() {
+      if chpl__reduceLockFree(eltType) then
+        return min(value, combined.read(memory_order_relaxed));
+      else
+        return value;
+    }
     proc clone() return new MinReduceScanOp(eltType=eltType);
   }
 
   class LogicalAndReduceScanOp: ReduceScanOp {
     type eltType;
     var value = identity;
+    var combined: chpl__reduceAtomicType(eltType, eltType == bool);
 
+    proc initialize() {
+      if eltType == bool then
+        combined.write(true, memory_order_relaxed);
+    }
     proc identity return _land_id(eltType);
     proc accumulate(x) {
       value &&= x;
@@ -175,13 +282,23 @@ module ChapelReduce {
     proc combine(x) {
       value &&= x.value;
     }
-    proc generate() return value;
+    proc combineValue(x) where eltType == bool {
+      if !x then
+        combined.write(false, memory_order_relaxed);
+    }
+    proc generate() {
+      if eltType == bool then
+        return value && combined.read(memory_order_relaxed);
+      else
+        return value;
+    }
     proc clone() return new LogicalAndReduceScanOp(eltType=eltType);
   }
 
   class LogicalOrReduceScanOp: ReduceScanOp {
     type eltType;
     var value = identity;
+    var combined: chpl__reduceAtomicType(eltType, eltType == bool);
 
     proc identity return _lor_id(eltType);
     proc accumulate(x) {
@@ -193,14 +310,28 @@ module ChapelReduce {
     proc combine(x) {
       value ||= x.value;
     }
-    proc generate() return value;
+    proc combineValue(x) where eltType == bool {
+      if x then
+        combined.write(true, memory_order_relaxed);
+    }
+    proc generate() {
+      if eltType == bool then
+        return value || combined.read(memory_order_relaxed);
+      else
+        return value;
+    }
     proc clone() return new LogicalOrReduceScanOp(eltType=eltType);
   }
 
   class BitwiseAndReduceScanOp: ReduceScanOp {
     type eltType;
     var value = _band_id(eltType);
+    var combined: chpl__reduceAtomicType(eltType, isIntegralType(eltType));
 
+    proc initialize() {
+      if isIntegralType(eltType) then
+        combined.write(identity, memory_order_relaxed);
+    }
     proc identity return _band_id(eltType);
     proc accumulate(x) {
       value &= x;
@@ -211,13 +342,22 @@ module ChapelReduce {
     proc combine(x) {
       value &= x.value;
     }
-    proc generate() return value;
+    proc combineValue(x) where isIntegralType(eltType) {
+      combined.and(x, memory_order_relaxed);
+    }
+    proc generate() {
+      if isIntegralType(eltType) then
+        return value & combined.read(memory_order_relaxed);
+      else
+        return value;
+    }
     proc clone() return new BitwiseAndReduceScanOp(eltType=eltType);
   }
 
   class BitwiseOrReduceScanOp: ReduceScanOp {
     type eltType;
     var value = _bor_id(eltType);
+    var combined: chpl__reduceAtomicType(eltType, isIntegralType(eltType));
 
     proc identity return _bor_id(eltType);
     proc accumulate(x) {
@@ -229,13 +369,22 @@ module ChapelReduce {
     proc combine(x) {
       value |= x.value;
     }
-    proc generate() return value;
+    proc combineValue(x) where isIntegralType(eltType) {
+      combined.or(x, memory_order_relaxed);
+    }
+    proc generate() {
+      if isIntegralType(eltType) then
+        return value | combined.read(memory_order_relaxed);
+      else
+        return value;
+    }
     proc clone() return new BitwiseOrReduceScanOp(eltType=eltType);
   }
 
   class BitwiseXorReduceScanOp: ReduceScanOp {
     type eltType;
     var value = _bxor_id(eltType);
+    var combined: chpl__reduceAtomicType(eltType, isIntegralType(eltType));
 
     proc identity return _bxor_id(eltType);
     proc accumulate(x) {
@@ -247,7 +396,15 @@ module ChapelReduce {
     proc combine(x) {
       value ^= x.value;
     }
-    proc generate() return value;
+    proc combineValue(x) where isIntegralType(eltType) {
+      combined.xor(x, memory_order_relaxed);
+    }
+    proc generate() {
+      if isIntegralType(eltType) then
+        return value ^ combined.read(memory_order_relaxed);
+      else
+        return value;
+    }
     proc clone() return new BitwiseXorReduceScanOp(eltType=eltType);
   }
 
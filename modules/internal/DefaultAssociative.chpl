@@ -25,6 +25,20 @@ module DefaultAssociative {
   config param debugDefaultAssoc = false;
   config param debugAssocDataPar = false;
 
+  // The parallel iterators split the hash table into this many chunks of
+  // slots per task and let the tasks claim chunks as they finish, so that
+  // a task which lands on a densely filled run of slots does not leave
+  // the others idle.
+  config const defaultAssocChunksPerTask = 8;
+
+  // The most lock stripes a parSafe domain spreads concurrent adds and
+  // removes over; see DefaultAssociativeDom.tableLock.  Smaller tables
+  // use one stripe per slot.
+  config const defaultAssocLockStripes = 256;
+
+  if defaultAssocLockStripes <= 0 then
+    halt("defaultAssocLockStripes must be > 0");
+
   // TODO: make the domain parameterized by this?
   type chpl_table_index_type = int;
 
@@ -62,19 +76,86 @@ module DefaultAssociative {
     // We explicitly use processor atomics here since this is not
     // by design a distributed data structure
     var numEntries: atomic_int64;
-    var tableLock: atomicbool; // do not access directly, use function below
     var tableSizeNum = 1;
     var tableSize = chpl__primes(tableSizeNum);
     var tableDom = {0..tableSize-1};
     var table: [tableDom] chpl_TableEntry(idxType);
-  
+
+    // parSafe domains let any number of tasks add, remove and look up
+    // indices at once.  Those tasks hold the table shared and synchronize
+    // through two sets of lock stripes: one picked by the index's hash,
+    // so that no two tasks add or remove the same index at once, and one
+    // picked by the slot, so that two tasks adding different indices
+    // never claim the same slot.  Only resizing or clearing the table
+    // holds it exclusively.  There are as many stripes of each kind as
+    // slots, up to defaultAssocLockStripes, so a small domain doesn't pay
+    // for the full set.
+    //
+    // Do not access these directly, use the functions below.
+    var tableLock: atomicbool;    // held or wanted exclusively
+    var tableUsers: atomic_int64; // shared holders, or -1 if exclusive
+    var lockStripesDom = {0..#_numLockStripes()};
+    var keyLocks: [lockStripesDom] atomicbool;
+    var slotLocks: [lockStripesDom] atomicbool;
+
+    inline proc _numLockStripes() {
+      return if parSafe then min(defaultAssocLockStripes, tableSize) else 0;
+    }
+
+    // Match the lock stripes to a new table size.
+    //
+    // NOTE: Calls to this routine assume that the tableLock has been acquired.
+    //
+    proc _resizeLockStripes() {
+      const numStripes = _numLockStripes();
+      if lockStripesDom.size != numStripes then
+        lockStripesDom = {0..#numStripes};
+    }
+
     inline proc lockTable() {
       while tableLock.testAndSet() do chpl_task_yield();
+      while !tableUsers.compareExchange(0, -1) do chpl_task_yield();
     }
-  
+
     inline proc unlockTable() {
+      tableUsers.write(0);
       tableLock.clear();
     }
+
+    // A waiting exclusive holder keeps new shared holders out, so that
+    // a stream of adds cannot starve a resize.
+    inline proc lockTableShared() {
+      while true {
+        if !tableLock.read() {
+          const users = tableUsers.read();
+          if users >= 0 && tableUsers.compareExchange(users, users+1) then
+            return;
+        }
+        chpl_task_yield();
+      }
+    }
+
+    inline proc unlockTableShared() {
+      tableUsers.sub(1);
+    }
+
+    inline proc lockKey(idx: idxType) {
+      const stripe = chpl__defaultHashWrapper(idx) % keyLocks.size;
+      while keyLocks[stripe].testAndSet() do chpl_task_yield();
+    }
+
+    inline proc unlockKey(idx: idxType) {
+      keyLocks[chpl__defaultHashWrapper(idx) % keyLocks.size].clear();
+    }
+
+    inline proc lockSlot(slotNum: index(tableDom)) {
+      while slotLocks[slotNum % slotLocks.size].testAndSet() do
+        chpl_task_yield();
+    }
+
+    inline proc unlockSlot(slotNum: index(tableDom)) {
+      slotLocks[slotNum % slotLocks.size].clear();
+    }
   
     // TODO: An ugly [0..-1] domain appears several times in the code --
     //       replace with a named constant/param?
@@ -157,9 +238,10 @@ module DefaultAssociative {
       if debugDefaultAssoc {
         writeln("*** In associative domain standalone iterator");
       }
-      // We are simply slicing up the table here.  Trying to do something
-      //  more intelligent (like evenly dividing up the full slots, led
-      //  to poor speed ups.
+      // We are simply slicing up the table here, into more slices than
+      //  tasks so that the tasks can balance skewed occupancy between
+      //  themselves.  Trying to do something more intelligent (like
+      //  evenly dividing up the full slots, led to poor speed ups.
       const numIndices = tableSize;
       const numChunks = _computeNumChunks(numIndices);
 
@@ -174,15 +256,21 @@ module DefaultAssociative {
           }
         }
       } else {
-        coforall chunk in 0..#numChunks {
-          const (lo, hi) = _computeBlock(numIndices, numChunks,
-                                         chunk, numIndices-1);
-          if debugAssocDataPar then
-            writeln("*** chunk: ", chunk, " owns ", lo..hi);
-          for slot in lo..hi {
-            if table[slot].status == chpl__hash_status.full {
-              yield table[slot].idx;
+        const numSlotChunks = _numSlotChunks(numChunks, numIndices);
+        var nextChunk: atomic_int64;
+        coforall task in 0..#numChunks {
+          var chunk = nextChunk.fetchAdd(1);
+          while chunk < numSlotChunks {
+            const (lo, hi) = _computeBlock(numIndices, numSlotChunks,
+                                           chunk, numIndices-1);
+            if debugAssocDataPar then
+              writeln("*** task ", task, ": chunk: ", chunk, " owns ", lo..hi);
+            for slot in lo..hi {
+              if table[slot].status == chpl__hash_status.full {
+                yield table[slot].idx;
+              }
             }
+            chunk = nextChunk.fetchAdd(1);
           }
         }
       }
@@ -195,9 +283,10 @@ module DefaultAssociative {
                        else dataParTasksPerLocale;
       const ignoreRunning = dataParIgnoreRunningTasks;
       const minIndicesPerTask = dataParMinGranularity;
-      // We are simply slicing up the table here.  Trying to do something
-      //  more intelligent (like evenly dividing up the full slots, led
-      //  to poor speed ups.
+      // We are simply slicing up the table here, into more slices than
+      //  tasks so that the tasks can balance skewed occupancy between
+      //  themselves.  Trying to do something more intelligent (like
+      //  evenly dividing up the full slots, led to poor speed ups.
       // This requires that the zipppered domains match.
       const numIndices = tableSize;
   
@@ -222,12 +311,18 @@ module DefaultAssociative {
       if numChunks == 1 {
         yield (0..numIndices-1, this);
       } else {
-        coforall chunk in 0..#numChunks {
-          const (lo, hi) = _computeBlock(numIndices, numChunks,
-                                         chunk, numIndices-1);
-          if debugDefaultAssoc then
-            writeln("*** DI[", chunk, "]: tuple = ", (lo..hi,));
-          yield (lo..hi, this);
+        const numSlotChunks = _numSlotChunks(numChunks, numIndices);
+        var nextChunk: atomic_int64;
+        coforall task in 0..#numChunks {
+          var chunk = nextChunk.fetchAdd(1);
+          while chunk < numSlotChunks {
+            const (lo, hi) = _computeBlock(numIndices, numSlotChunks,
+                                           chunk, numIndices-1);
+            if debugDefaultAssoc then
+              writeln("*** DI[", task, "]: tuple = ", (lo..hi,));
+            yield (lo..hi, this);
+            chunk = nextChunk.fetchAdd(1);
+          }
         }
       }
     }
@@ -305,22 +400,77 @@ module DefaultAssociative {
       const inSlot = slotNum;
       var retVal = 0;
       on this {
-        const shouldLock = needLock && parSafe;
-        if shouldLock then lockTable();
-        var findAgain = shouldLock;
-        if ((numEntries.read()+1)*2 > tableSize) {
-          _resize(grow=true);
-          findAgain = true;
+        if needLock && parSafe {
+          (slotNum, retVal) = _addShared(idx);
+        } else {
+          var findAgain = false;
+          if ((numEntries.read()+1)*2 > tableSize) {
+            _resize(grow=true);
+            findAgain = true;
+          }
+          if findAgain then
+            (slotNum, retVal) = _add(idx, -1);
+          else
+            (_, retVal) = _add(idx, inSlot);
         }
-        if findAgain then
-          (slotNum, retVal) = _add(idx, -1);
-        else
-          (_, retVal) = _add(idx, inSlot);
-        if shouldLock then unlockTable();
       }
       return (slotNum, retVal);
     }
 
+    // Adds idx to a parSafe domain while other tasks may be adding,
+    // removing or looking up other indices; see tableLock.
+    proc _addShared(idx: idxType) {
+      var probeFull = false;
+      while true {
+        lockTableShared();
+
+        if (numEntries.read()+1)*2 <= tableSize || postponeResize {
+          lockKey(idx);
+          var (found, slotNum) = _findFilledSlot(idx, needLock=false);
+
+          // The key lock keeps idx from being added behind our back, but
+          // another index may take the open slot first; look again if so.
+          while !found && slotNum != -1 {
+            lockSlot(slotNum);
+            if table[slotNum].status != chpl__hash_status.full {
+              table[slotNum].idx = idx;
+              table[slotNum].status = chpl__hash_status.full;
+              unlockSlot(slotNum);
+              numEntries.add(1);
+              unlockKey(idx);
+              unlockTableShared();
+              return (slotNum, 1);
+            }
+            unlockSlot(slotNum);
+            (found, slotNum) = _findFilledSlot(idx, needLock=false);
+          }
+
+          unlockKey(idx);
+          unlockTableShared();
+
+          if found then
+            return (slotNum, 0);
+
+          if postponeResize then
+            halt("couldn't add ", idx, " -- ", numEntries.read(), " / ", tableSize, " taken");
+
+          // Adds racing past the size check can fill idx's probe sequence;
+          // grow the table even though it may not look full.
+          probeFull = true;
+        } else {
+          unlockTableShared();
+        }
+
+        lockTable();
+        if probeFull || (numEntries.read()+1)*2 > tableSize then
+          _resize(grow=true);
+        unlockTable();
+        probeFull = false;
+      }
+      halt("unreachable");
+      return (-1, 0);
+    }
+
     // This routine adds new indices without checking the table size and
     //  is thus appropriate for use by routines like _resize().
     //
@@ -348,8 +498,11 @@ module DefaultAssociative {
     proc dsiRemove(idx: idxType) {
       var retval = 1;
       on this {
-        if parSafe then lockTable();
-        const (foundSlot, slotNum) = _findFilledSlot(idx, needLock=!parSafe);
+        if parSafe {
+          lockTableShared();
+          lockKey(idx);
+        }
+        const (foundSlot, slotNum) = _findFilledSlot(idx, needLock=false);
         if (foundSlot) {
           for a in _arrs do
             a.clearEntry(idx);
@@ -358,10 +511,17 @@ module DefaultAssociative {
         } else {
           retval = 0;
         }
+        if parSafe {
+          unlockKey(idx);
+          unlockTableShared();
+        }
         if (numEntries.read()*8 < tableSize && tableSizeNum > 1) {
-          _resize(grow=false);
+          if parSafe then lockTable();
+          if (numEntries.read()*8 < tableSize && tableSizeNum > 1) {
+            _resize(grow=false);
+          }
+          if parSafe then unlockTable();
         }
-        if parSafe then unlockTable();
       }
       return retval;
     }
@@ -404,22 +564,21 @@ module DefaultAssociative {
           tableSizeNum = primeLoc;
           tableSize = prime;
           tableDom = {0..tableSize-1};
+          _resizeLockStripes();
 
           //numEntries will be reconstructed as keys are readded
           numEntries.write(0);
 
           // insert old data into newly resized table
-          for slot in _fullSlots(copyTable) {
-            const (newslot, _) = _add(copyTable[slot].idx);
-            _preserveArrayElements(oldslot=slot, newslot=newslot);
-          }
-            
+          _rehash(copyTable);
+
           _removeArrayBackups();
         } else {
           //Fast path, nothing to backup
           tableSizeNum=primeLoc;
           tableSize=prime;
           tableDom = {0..tableSize-1};
+          _resizeLockStripes();
         }
 
         //Unlock the table
@@ -464,22 +623,66 @@ module DefaultAssociative {
       if tableSizeNum > chpl__primes.size then halt("associative array exceeds maximum size");
       tableSize = chpl__primes(tableSizeNum);
       tableDom = {0..tableSize-1};
+      _resizeLockStripes();
   
       // insert old data into newly resized table
-      for slot in _fullSlots(copyTable) {
-        const (newslot, _) = _add(copyTable[slot].idx);
-        _preserveArrayElements(oldslot=slot, newslot=newslot);
-      }
-      
+      _rehash(copyTable);
+
       _removeArrayBackups();
     }
 
+    // Adds the indices of copyTable to the table, which must be empty,
+    // and moves the arrays' elements along with them.
+    //
+    // NOTE: Calls to this routine assume that the tableLock has been acquired.
+    //
+    proc _rehash(copyTable) {
+      if parSafe {
+        // The indices are distinct, so tasks only need to keep from
+        // claiming the same slot.
+        var numAdded = 0;
+        forall slot in copyTable.domain with (+ reduce numAdded) {
+          if copyTable[slot].status == chpl__hash_status.full {
+            const newslot = _addUnique(copyTable[slot].idx);
+            _preserveArrayElements(oldslot=slot, newslot=newslot);
+            numAdded += 1;
+          }
+        }
+        numEntries.write(numAdded);
+      } else {
+        for slot in _fullSlots(copyTable) {
+          const (newslot, _) = _add(copyTable[slot].idx);
+          _preserveArrayElements(oldslot=slot, newslot=newslot);
+        }
+      }
+    }
+
+    // Puts idx, which is known not to be in the table, in the first empty
+    // slot of its probe sequence that no other task claims first.  Does
+    // not update numEntries.
+    proc _addUnique(idx: idxType): index(tableDom) {
+      for slotNum in _lookForSlots(idx) {
+        if table[slotNum].status == chpl__hash_status.empty {
+          lockSlot(slotNum);
+          if table[slotNum].status == chpl__hash_status.empty {
+            table[slotNum].idx = idx;
+            table[slotNum].status = chpl__hash_status.full;
+            unlockSlot(slotNum);
+            return slotNum;
+          }
+          unlockSlot(slotNum);
+        }
+      }
+      halt("couldn't add ", idx, " -- ", numEntries.read(), " / ", tableSize, " taken");
+      return -1;
+    }
+
     // Searches for 'idx' in a filled slot.
     //
     // Returns true if found, along with the first open slot that may be
     // re-used for faster addition to the domain
     proc _findFilledSlot(idx: idxType, needLock = true) : (bool, index(tableDom)) {
-      if parSafe && needLock then lockTable();
+      if parSafe && needLock then lockTableShared();
       var firstOpen = -1;
       for slotNum in _lookForSlots(idx, table.domain.high+1) {
         const slotStatus = table[slotNum].status;
@@ -487,19 +690,19 @@ module DefaultAssociative {
         // be found past this point.
         if (slotStatus == chpl__hash_status.empty) {
           if firstOpen == -1 then firstOpen = slotNum;
-          if parSafe && needLock then unlockTable();
+          if parSafe && needLock then unlockTableShared();
           return (false, firstOpen);
         } else if (slotStatus == chpl__hash_status.full) {
           if (table[slotNum].idx == idx) {
-            if parSafe && needLock then unlockTable();
+            if parSafe && needLock then unlockTableShared();
             return (true, slotNum);
           }
         } else { // this entry was removed, but is the first slot we could use
           if firstOpen == -1 then firstOpen = slotNum;
         }
       }
-      if parSafe && needLock then unlockTable();
-      return (false, -1);
+      if parSafe && needLock then unlockTableShared();
+      return (false, firstOpen);
     }
 
     //
@@ -534,6 +737,13 @@ module DefaultAssociative {
       }
     }
   
+    // The number of chunks of slots the parallel iterators hand out to
+    // numTasks tasks.
+    proc _numSlotChunks(numTasks: int, numSlots: int) {
+      return max(numTasks, min(numTasks * defaultAssocChunksPerTask,
+                               numSlots));
+    }
+
     iter _fullSlots(tab = table) {
       for slot in tab.domain {
         if tab[slot].status == chpl__hash_status.full then
@@ -642,17 +852,22 @@ module DefaultAssociative {
           }
         }
       } else {
-        coforall chunk in 0..#numChunks {
-          const (lo, hi) = _computeBlock(numIndices, numChunks,
-                                         chunk, numIndices-1);
-          if debugAssocDataPar {
-            writeln("In associative array standalone iterator: chunk = ", chunk);
-          }
-          var table = dom.table;
-          for slot in lo..hi {
-            if dom.table[slot].status == chpl__hash_status.full {
-              yield data[slot];
+        const numSlotChunks = dom._numSlotChunks(numChunks, numIndices);
+        var nextChunk: atomic_int64;
+        coforall task in 0..#numChunks {
+          var chunk = nextChunk.fetchAdd(1);
+          while chunk < numSlotChunks {
+            const (lo, hi) = _computeBlock(numIndices, numSlotChunks,
+                                           chunk, numIndices-1);
+            if debugAssocDataPar {
+              writeln("In associative array standalone iterator: chunk = ", chunk);
+            }
+            for slot in lo..hi {
+              if dom.table[slot].status == chpl__hash_status.full {
+                yield data[slot];
+              }
             }
+            chunk = nextChunk.fetchAdd(1);
           }
         }
       }
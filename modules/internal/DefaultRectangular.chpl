@@ -24,8 +24,16 @@ module DefaultRectangular {
   config const dataParIgnoreRunningTasks = false;
   config const dataParMinGranularity: int = 1;
 
+  // Parallel iteration over multi-dimensional domains hands each task's
+  // block out in tiles dataParTileSize indices on a side, so that kernels
+  // such as transposes and stencils reuse cache lines before they are
+  // evicted.  0 disables tiling; -1 sizes tiles to dataParTileCacheBytes.
+  config const dataParTileSize = 0;
+  config const dataParTileCacheBytes = 256*1024;
+
   if dataParTasksPerLocale<0 then halt("dataParTasksPerLocale must be >= 0");
   if dataParMinGranularity<=0 then halt("dataParMinGranularity must be > 0");
+  if dataParTileSize < -1 then halt("dataParTileSize must be >= -1");
 
   use DSIUtil, ChapelArray;
   config param debugDefaultDist = false;
@@ -229,7 +237,43 @@ module DefaultRectangular {
                 "### nranges = ", ranges);
       }
 
-      if numChunks <= 1 {
+      // Convert a block of zero-based offsets into a block of indices
+      proc offsetsToIndices(followMe) {
+        var block: rank*range(idxType=idxType, stridable=stridable);
+        if stridable {
+          type strType = chpl__signedType(idxType);
+          for param i in 1..rank {
+            // Note that a range.stride is signed, even if the range is not
+            const rStride = ranges(i).stride;
+            const rSignedStride = rStride:strType;
+            if rStride > 0 {
+              // Since stride is positive, the following line results
+              // in a positive number, so casting it to e.g. uint is OK
+              const riStride = rStride:idxType;
+              const low = ranges(i).alignedLow + followMe(i).low*riStride,
+                    high = ranges(i).alignedLow + followMe(i).high*riStride,
+                    stride = rSignedStride;
+              block(i) = low..high by stride;
+            } else {
+              // Stride is negative, so the following number is positive.
+              const riStride = (-rStride):idxType;
+              const low = ranges(i).alignedHigh - followMe(i).high*riStride,
+                    high = ranges(i).alignedHigh - followMe(i).low*riStride,
+                    stride = rSignedStride;
+              block(i) = low..high by stride;
+            }
+          }
+        } else {
+          for  param i in 1..rank do
+            block(i) = ranges(i).low+followMe(i).low:idxType..ranges(i).low+followMe(i).high:idxType;
+        }
+        return block;
+      }
+
+      const tileSize = _computeTileSize(rank, dataParTileSize,
+                                        dataParTileCacheBytes);
+
+      if numChunks <= 1 && (rank == 1 || tileSize <= 0) {
         for i in these_help(1) {
           yield i;
         }
@@ -241,47 +285,29 @@ module DefaultRectangular {
         if debugDefaultDist {
           chpl_debug_writeln("*** DI: locBlock = ", locBlock);
         }
-        coforall chunk in 0..#numChunks {
-          var followMe: rank*range(idxType) = locBlock;
-          const (lo,hi) = _computeBlock(locBlock(parDim).length,
-                                        numChunks, chunk,
-                                        locBlock(parDim).high,
-                                        locBlock(parDim).low,
-                                        locBlock(parDim).low);
-          followMe(parDim) = lo..hi;
-          if debugDefaultDist {
-            chpl_debug_writeln("*** DI[", chunk, "]: followMe = ", followMe);
+        if numChunks <= 1 {
+          for followMe in _tiledBlocks(locBlock, tileSize) {
+            for i in these_help(1, offsetsToIndices(followMe)) {
+              yield i;
+            }
           }
-          var block: rank*range(idxType=idxType, stridable=stridable);
-          if stridable {
-            type strType = chpl__signedType(idxType);
-            for param i in 1..rank {
-              // Note that a range.stride is signed, even if the range is not
-              const rStride = ranges(i).stride;
-              const rSignedStride = rStride:strType;
-              if rStride > 0 {
-                // Since stride is positive, the following line results
-                // in a positive number, so casting it to e.g. uint is OK
-                const riStride = rStride:idxType;
-                const low = ranges(i).alignedLow + followMe(i).low*riStride,
-                      high = ranges(i).alignedLow + followMe(i).high*riStride,
-                      stride = rSignedStride;
-                block(i) = low..high by stride;
-              } else {
-                // Stride is negative, so the following number is positive.
-                const riStride = (-rStride):idxType;
-                const low = ranges(i).alignedHigh - followMe(i).high*riStride,
-                      high = ranges(i).alignedHigh - followMe(i).low*riStride,
-                      stride = rSignedStride;
-                block(i) = low..high by stride;
+        } else {
+          coforall chunk in 0..#numChunks {
+            var chunkBlock: rank*range(idxType) = locBlock;
+            const (lo,hi) = _computeBlock(locBlock(parDim).length,
+                                          numChunks, chunk,
+                                          locBlock(parDim).high,
+                                          locBlock(parDim).low,
+                                          locBlock(parDim).low);
+            chunkBlock(parDim) = lo..hi;
+            if debugDefaultDist {
+              chpl_debug_writeln("*** DI[", chunk, "]: followMe = ", chunkBlock);
+            }
+            for followMe in _tiledBlocks(chunkBlock, tileSize) {
+              for i in these_help(1, offsetsToIndices(followMe)) {
+                yield i;
               }
             }
-          } else {
-            for  param i in 1..rank do
-              block(i) = ranges(i).low+followMe(i).low:idxType..ranges(i).low+followMe(i).high:idxType;
-          }
-          for i in these_help(1, block) {
-            yield i;
           }
         }
       }
@@ -295,6 +321,8 @@ module DefaultRectangular {
       where tag == iterKind.leader {
 
       const numSublocs = here.getChildCount();
+      const tileSize = _computeTileSize(rank, dataParTileSize,
+                                        dataParTileCacheBytes);
 
       if localeModelHasSublocales && numSublocs != 0 {
         var dptpl = if tasksPerLocale==0 then here.maxTaskPar
@@ -329,7 +357,8 @@ module DefaultRectangular {
             var block: rank*range(idxType);
             for param i in 1..rank do
               block(i) = offset(i)..#ranges(i).length;
-            yield block;
+            for tile in _tiledBlocks(block, tileSize) do
+              yield tile;
           }
         } else {
           coforall chunk in 0..#numChunks { // make sure coforall on can trigger
@@ -373,7 +402,8 @@ module DefaultRectangular {
                   chpl_debug_writeln("### chunk = ", chunk, "  chunk2 = ", chunk2, "  " +
                           "followMe = ", followMe, "  followMe2 = ", followMe2);
                 }
-                yield followMe2;
+                for tile in _tiledBlocks(followMe2, tileSize) do
+                  yield tile;
               }
             }
           }
@@ -414,7 +444,8 @@ module DefaultRectangular {
             var block: rank*range(idxType);
             for param i in 1..rank do
               block(i) = offset(i)..#ranges(i).length;
-            yield block;
+            for tile in _tiledBlocks(block, tileSize) do
+              yield tile;
           }
         } else {
           var locBlock: rank*range(idxType);
@@ -432,7 +463,8 @@ module DefaultRectangular {
             followMe(parDim) = lo..hi;
             if debugDefaultDist then
               chpl_debug_writeln("*** DI[", chunk, "]: followMe = ", followMe);
-            yield followMe;
+            for tile in _tiledBlocks(followMe, tileSize) do
+              yield tile;
           }
         }
       }
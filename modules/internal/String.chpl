@@ -97,6 +97,26 @@ module String {
 
   private config param debugStrings = false;
 
+  // Strings of length one don't allocate: they refer, without owning it,
+  // to the runtime's read-only copy of their byte followed by a NUL.
+  // Operations that write into a buffer in place must copy such strings
+  // first, just as for any other string that doesn't own its buffer.
+  private extern proc chpl_string_single_byte(b: uint(8)): bufferType;
+
+  private inline proc singleByteString(b: uint(8)): string {
+    return new string(chpl_string_single_byte(b), 1, 2,
+                      owned=false, needToCopy=false);
+  }
+
+  // Byte-string search over buffers with explicit lengths, returning a
+  // 0-based offset or -1 (see chpl-string-support.c).
+  private extern proc chpl_string_find(haystack: bufferType, haystackLen: int,
+                                       needle: bufferType, needleLen: int): int;
+  private extern proc chpl_string_rfind(haystack: bufferType, haystackLen: int,
+                                        needle: bufferType, needleLen: int): int;
+  private extern proc chpl_string_count(haystack: bufferType, haystackLen: int,
+                                        needle: bufferType, needleLen: int): int;
+
   //
   // String Implementation
   //
@@ -325,8 +345,6 @@ module String {
      */
     iter these() : string {
       for i in 1..this.len {
-        // This is pretty painful from a performance perspective right now,
-        // allocates w/ every yield
         yield this[i];
       }
     }
@@ -341,23 +359,15 @@ module String {
       if boundsChecking && (i <= 0 || i > this.len)
         then halt("index out of bounds of string: ", i);
 
-      var ret: string;
-      const newSize = chpl_here_good_alloc_size(2);
-      ret._size = max(chpl_string_min_alloc_size, newSize);
-      ret.len = 1;
-      ret.buff = chpl_here_alloc(ret._size,
-                                CHPL_RT_MD_STR_COPY_DATA): bufferType;
-      ret.owned = true;
-
+      var b: uint(8);
       const remoteThis = this.locale_id != chpl_nodeID;
       if remoteThis {
-        chpl_string_comm_get(ret.buff, this.locale_id, this.buff + i - 1, 1);
+        chpl_string_comm_get(c_ptrTo(b), this.locale_id, this.buff + i - 1, 1);
       } else {
-        ret.buff[0] = this.buff[i-1];
+        b = this.buff[i-1];
       }
-      ret.buff[1] = 0;
 
-      return ret;
+      return singleByteString(b);
     }
 
     // Checks to see if r is inside the bounds of this and returns a finite
@@ -382,6 +392,45 @@ module String {
       return ret;
     }
 
+    // Makes sure this string owns a buffer with room for at least
+    // `capacity` bytes plus the terminating NUL, so that appends up to
+    // that length don't reallocate.  Used by StringBuilder.
+    pragma "no doc"
+    proc ref _reserve(capacity: int) {
+      if capacity < this._size && this.owned then return;
+
+      on __primitive("chpl_on_locale_num",
+                     chpl_buildLocaleID(this.locale_id, c_sublocid_any)) {
+        const newSize = chpl_here_good_alloc_size(max(capacity, this.len)+1);
+        if this.owned && this.buff != nil {
+          this.buff = chpl_here_realloc(this.buff, newSize,
+                                        CHPL_RT_MD_STR_COPY_DATA):bufferType;
+        } else {
+          var newBuff = chpl_here_alloc(newSize,
+                                        CHPL_RT_MD_STR_COPY_DATA):bufferType;
+          if this.len > 0 then c_memcpy(newBuff, this.buff, this.len);
+          newBuff[this.len] = 0;
+          this.buff = newBuff;
+          this.owned = true;
+        }
+        this._size = newSize;
+      }
+    }
+
+    // Empties this string but keeps its buffer, if it owns one, for reuse.
+    pragma "no doc"
+    proc ref _truncate() {
+      if this.owned && this.buff != nil {
+        on __primitive("chpl_on_locale_num",
+                       chpl_buildLocaleID(this.locale_id, c_sublocid_any)) {
+          this.len = 0;
+          this.buff[0] = 0;
+        }
+      } else {
+        this = "";
+      }
+    }
+
     /*
       Slice a string. Halts if r is not completely inside the range
       `1..string.length`.
@@ -400,6 +449,8 @@ module String {
       if r2.size <= 0 {
         // TODO: I can't just return "" (ret var gets freed for some reason)
         ret = "";
+      } else if r2.size == 1 {
+        return this[r2.first:int];
       } else {
         ret.len = r2.size:int;
         const newSize = chpl_here_good_alloc_size(ret.len+1);
@@ -475,7 +526,7 @@ module String {
           }
           if needle.len > this.len then continue;
 
-          const localNeedle: string = needle.localize();
+          const localNeedle = needle.localize();
 
           const needleR = 0:int..#localNeedle.len;
           if fromLeft {
@@ -516,9 +567,6 @@ module String {
 
 
     // Helper function that uses a param bool to toggle between count and find
-    //TODO: this could be a much better string search
-    //      (Boyer-Moore-Horspool|any thing other than brute force)
-    //
     pragma "no doc"
     inline proc _search_helper(needle: string, region: range(?),
                                param count: bool, param fromLeft: bool = true) {
@@ -553,9 +601,25 @@ module String {
           localRet = 0;
         }
 
+        if localRet == -1 && view.stride == 1 {
+          // contiguous region: hand it to the runtime's search
+          const localNeedle = needle.localize();
+          const first = view.first:int;
+          const haystack = this.buff + (first-1);
+          if count {
+            localRet = chpl_string_count(haystack, thisLen,
+                                         localNeedle.buff, nLen);
+          } else {
+            const offset = if fromLeft
+              then chpl_string_find(haystack, thisLen, localNeedle.buff, nLen)
+              else chpl_string_rfind(haystack, thisLen, localNeedle.buff, nLen);
+            localRet = if offset < 0 then 0 else first + offset;
+          }
+        }
+
         if localRet == -1 {
           localRet = 0;
-          const localNeedle: string = needle.localize();
+          const localNeedle = needle.localize();
 
           // i *is not* an index into anything, it is the order of the element
           // of view we are searching from.
@@ -633,22 +697,55 @@ module String {
       :returns: a copy of the string where `needle` replaces `replacement` up
                 to `count` times
      */
-    // TODO: not ideal - count and single allocation probably faster
-    //                 - can special case on replacement|needle.length (0, 1)
     proc replace(needle: string, replacement: string, count: int = -1) : string {
-      var result: string = this;
+      var result: string;
+      const localThis = this.localize();
+      const localNeedle = needle.localize();
+      const localReplacement = replacement.localize();
+      const thisLen = localThis.len;
+      const nLen = localNeedle.len;
+      const rLen = localReplacement.len;
+
+      // Count the matches first so the result is allocated only once.
       var found: int = 0;
-      var startIdx: int = 1;
-      const localNeedle: string = needle.localize();
-      const localReplacement: string = replacement.localize();
+      if nLen != 0 {
+        var pos: int = 0;
+        while (count < 0) || (found < count) {
+          const offset = chpl_string_find(localThis.buff+pos, thisLen-pos,
+                                          localNeedle.buff, nLen);
+          if offset < 0 then break;
+          found += 1;
+          pos += offset + nLen;
+        }
+      }
 
-      while (count < 0) || (found < count) {
-        const idx = result.find(localNeedle, startIdx..);
-        if !idx then break;
+      if found == 0 {
+        result = localThis;
+        return result;
+      }
 
-        found += 1;
-        result = result[..idx-1] + localReplacement + result[(idx + localNeedle.length)..];
-        startIdx = idx + localReplacement.length;
+      const newLen = thisLen + found*(rLen-nLen);
+      if newLen != 0 {
+        const allocSize = chpl_here_good_alloc_size(newLen+1);
+        result.buff = chpl_here_alloc(allocSize,
+                                      CHPL_RT_MD_STR_COPY_DATA):bufferType;
+        result._size = allocSize;
+        result.len = newLen;
+
+        var src: int = 0;
+        var dst: int = 0;
+        for 1..found {
+          const offset = chpl_string_find(localThis.buff+src, thisLen-src,
+                                          localNeedle.buff, nLen);
+          c_memcpy(result.buff+dst, localThis.buff+src, offset);
+          dst += offset;
+          if rLen != 0 then
+            c_memcpy(result.buff+dst, localReplacement.buff, rLen);
+          dst += rLen;
+          src += offset + nLen;
+        }
+        c_memcpy(result.buff+dst, localThis.buff+src, thisLen-src);
+        result.buff[newLen] = 0;
       }
       return result;
     }
@@ -668,8 +765,8 @@ module String {
     // TODO: specifying return type leads to un-inited string?
     iter split(sep: string, maxsplit: int = -1, ignoreEmpty: bool = false) /* : string */ {
       if !(maxsplit == 0 && ignoreEmpty && this.isEmptyString()) {
-        const localThis: string = this.localize();
-        const localSep: string = sep.localize();
+        const localThis = this.localize();
+        const localSep = sep.localize();
 
         // really should be <, but we need to avoid returns and extra yields so
         // the iterator gets inlined
@@ -686,8 +783,12 @@ module String {
             chunk = localThis;
             done = true;
           } else {
-            if (splitAll || splitCount < maxsplit) then
-              end = localThis.find(localSep, start..);
+            if (splitAll || splitCount < maxsplit) && localSep.len != 0 {
+              const offset = chpl_string_find(localThis.buff+(start-1),
+                                              localThis.len-(start-1),
+                                              localSep.buff, localSep.len);
+              end = if offset < 0 then 0 else start + offset;
+            }
 
             if(end == 0) {
               // Separator not found
@@ -721,7 +822,7 @@ module String {
     // TODO: specifying return type leads to un-inited string?
     iter split(maxsplit: int = -1) /* : string */ {
       if !this.isEmptyString() {
-        const localThis: string = this.localize();
+        const localThis = this.localize();
         var done : bool = false;
         var yieldChunk : bool = false;
         var chunk : string;
@@ -892,8 +993,8 @@ module String {
       if this.isEmptyString() then return "";
       if chars.isEmptyString() then return this;
 
-      const localThis: string = this.localize();
-      const localChars: string = chars.localize();
+      const localThis = this.localize();
+      const localChars = chars.localize();
 
       var start = 1;
       var end = localThis.len;
@@ -1162,7 +1263,8 @@ module String {
                 lowercase counterpart.
     */
     proc toLower() : string {
-      var result: string = this;
+      // copy, in case this doesn't own its buffer
+      var result = new string(this);
       if result.isEmptyString() then return result;
 
       for i in 0..#result.len {
@@ -1180,7 +1282,8 @@ module String {
                 uppercase counterpart.
     */
     proc toUpper() : string {
-      var result: string = this;
+      // copy, in case this doesn't own its buffer
+      var result = new string(this);
       if result.isEmptyString() then return result;
 
       for i in 0..#result.len {
@@ -1198,7 +1301,8 @@ module String {
                 following another cased character converted to lowercase.
      */
     proc toTitle() : string {
-      var result: string = this;
+      // copy, in case this doesn't own its buffer
+      var result = new string(this);
       if result.isEmptyString() then return result;
 
       param UN = 0, LETTER = 1;
@@ -1258,20 +1362,26 @@ module String {
     if slen != 0 {
       if _local || s.locale_id == chpl_nodeID {
         if s.owned {
-          ret.buff = chpl_here_alloc(s._size,
+          // size the copy for its contents, not for any room s has to grow
+          const allocSize = chpl_here_good_alloc_size(slen+1);
+          ret.buff = chpl_here_alloc(allocSize,
                                     CHPL_RT_MD_STR_COPY_DATA): bufferType;
-          c_memcpy(ret.buff, s.buff, s.len);
-          ret.buff[s.len] = 0;
+          c_memcpy(ret.buff, s.buff, slen);
+          ret.buff[slen] = 0;
+          ret._size = allocSize;
         } else {
+          // don't inherit the room the owner of buff has to grow, or +=
+          // on this copy would write into the owner's string
           ret.buff = s.buff;
+          ret._size = slen+1;
         }
         ret.owned = s.owned;
       } else {
         ret.buff = copyRemoteBuffer(s.locale_id, s.buff, slen);
         ret.owned = true;
+        ret._size = slen+1;
       }
       ret.len = slen;
-      ret._size = slen+1;
     }
     return ret;
   }
@@ -1298,20 +1408,26 @@ module String {
     if slen != 0 {
       if _local || s.locale_id == chpl_nodeID {
         if s.owned {
-          ret.buff = chpl_here_alloc(s._size,
+          // size the copy for its contents, not for any room s has to grow
+          const allocSize = chpl_here_good_alloc_size(slen+1);
+          ret.buff = chpl_here_alloc(allocSize,
                                     CHPL_RT_MD_STR_COPY_DATA): bufferType;
-          c_memcpy(ret.buff, s.buff, s.len);
-          ret.buff[s.len] = 0;
+          c_memcpy(ret.buff, s.buff, slen);
+          ret.buff[slen] = 0;
+          ret._size = allocSize;
         } else {
+          // don't inherit the room the owner of buff has to grow, or +=
+          // on this copy would write into the owner's string
           ret.buff = s.buff;
+          ret._size = slen+1;
         }
         ret.owned = s.owned;
       } else {
         ret.buff = copyRemoteBuffer(s.locale_id, s.buff, slen);
         ret.owned = true;
+        ret._size = slen+1;
       }
       ret.len = slen;
-      ret._size = slen+1;
     }
     return ret;
   }
@@ -1559,7 +1675,8 @@ module String {
                    chpl_buildLocaleID(lhs.locale_id, c_sublocid_any)) {
       const rhsLen = rhs.len;
       const newLength = lhs.len+rhsLen; //TODO: check for overflow
-      if lhs._size <= newLength {
+      // only append in place to a buffer this string owns
+      if lhs._size <= newLength || !lhs.owned {
         const newSize = chpl_here_good_alloc_size(
             max(newLength+1, lhs.len*chpl_stringGrowthFactor):int);
 
@@ -1641,8 +1758,8 @@ module String {
       return ret;
     } else { */
 
-    var localA: string = a.localize();
-    var localB: string = b.localize();
+    var localA = a.localize();
+    var localB = b.localize();
 
     return doEq(localA, localB);
   }
@@ -1658,8 +1775,8 @@ module String {
       return _strcmp(a, b) < 0;
     }
 
-    var localA: string = a.localize();
-    var localB: string = b.localize();
+    var localA = a.localize();
+    var localB = b.localize();
 
     return doLt(localA, localB);
   }
@@ -1670,8 +1787,8 @@ module String {
       return _strcmp(a, b) > 0;
     }
 
-    var localA: string = a.localize();
-    var localB: string = b.localize();
+    var localA = a.localize();
+    var localB = b.localize();
 
     return doGt(localA, localB);
   }
@@ -1745,11 +1862,7 @@ module String {
      :returns: A string with the single character with the ASCII value `i`.
   */
   inline proc asciiToString(i: uint(8)) {
-    var buffer = chpl_here_alloc(2, CHPL_RT_MD_STR_COPY_DATA): bufferType;
-    buffer[0] = i;
-    buffer[1] = 0;
-    var s = new string(buffer, 1, 2, owned=true, needToCopy=false);
-    return s;
+    return singleByteString(i);
   }
 
 
@@ -74,6 +74,9 @@ BLAS Implementations:
       pointers, instead of ``void*`` pointers.  Using this will likely result in
       warnings about incompatible pointer types. These may be ignored.
 
+  Programs that only use BLAS through :mod:`LinearAlgebra` can be compiled
+  with :param:`noBLAS` when no implementation is available.
+
 Cray Systems:
   No compiler flags should be necessary when compiling BLAS programs on
   Crays. The **CrayBLAS** implementation is made available through Cray's libsci,
@@ -179,16 +182,40 @@ module BLAS {
   */
   config param isBLAS_MKL=false;
 
+  /*
+    Set this to `true` to compile without any BLAS implementation.  No BLAS
+    header is required, and the routines in this module may not be called.
+    :mod:`LinearAlgebra` uses its native Chapel routines instead.
+  */
+  config param noBLAS=false;
+
   use C_BLAS;
 
   use SysCTypes;
 
-  if (isBLAS_MKL) {
+  if noBLAS {
+    // nothing to require
+  } else if (isBLAS_MKL) {
     require "mkl_cblas.h";
   } else {
     require "cblas.h";
   }
 
+  // Check that the enums of this module agree with the BLAS header
+  if !noBLAS {
+    assert(Order.Row:c_int == CblasRowMajor,"Enum value for Order.Row does not agree with CblasRowMajor");
+    assert(Order.Col:c_int == CblasColMajor,"Enum value for Order.Col does not agree with CblasColMajor");
+    assert(Op.N:c_int == CblasNoTrans,"Enum value for Op.N does not agree with CblasNoTrans");
+    assert(Op.T:c_int == CblasTrans,"Enum value for Op.T does not agree with CblasTrans");
+    assert(Op.H:c_int == CblasConjTrans,"Enum value for Op.H does not agree with CblasConjTrans");
+    assert(Uplo.Upper:c_int == CblasUpper,"Enum value for Uplo.Upper does not agree with CblasUpper");
+    assert(Uplo.Lower:c_int == CblasLower,"Enum value for Uplo.Lower does not agree with CblasLower");
+    assert(Diag.NonUnit:c_int == CblasNonUnit,"Enum value for Diag.NonUnit does not agree with CblasNonUnit");
+    assert(Diag.Unit:c_int == CblasUnit,"Enum value for Diag.Unit does not agree with CblasUnit");
+    assert(Side.Left:c_int == CblasLeft,"Enum value for Side.Left does not agree with CblasLeft");
+    assert(Side.Right:c_int == CblasRight,"Enum value for Side.Right does not agree with CblasRight");
+  }
+
   /* Return `true` if type is supported by BLAS */
   proc isBLASType(type t) param: bool{
     return isRealType(t) || isComplexType(t);
@@ -2407,20 +2434,6 @@ module BLAS {
     extern const CblasLeft : CBLAS_SIDE;
     extern const CblasRight : CBLAS_SIDE;
 
-    {
-      assert(Order.Row:c_int == CblasRowMajor,"Enum value for Order.Row does not agree with CblasRowMajor");
-      assert(Order.Col:c_int == CblasColMajor,"Enum value for Order.Col does not agree with CblasColMajor");
-      assert(Op.N:c_int == CblasNoTrans,"Enum value for Op.N does not agree with CblasNoTrans");
-      assert(Op.T:c_int == CblasTrans,"Enum value for Op.T does not agree with CblasTrans");
-      assert(Op.H:c_int == CblasConjTrans,"Enum value for Op.H does not agree with CblasConjTrans");
-      assert(Uplo.Upper:c_int == CblasUpper,"Enum value for Uplo.Upper does not agree with CblasUpper");
-      assert(Uplo.Lower:c_int == CblasLower,"Enum value for Uplo.Lower does not agree with CblasLower");
-      assert(Diag.NonUnit:c_int == CblasNonUnit,"Enum value for Diag.NonUnit does not agree with CblasNonUnit");
-      assert(Diag.Unit:c_int == CblasUnit,"Enum value for Diag.Unit does not agree with CblasUnit");
-      assert(Side.Left:c_int == CblasLeft,"Enum value for Side.Left does not agree with CblasLeft");
-      assert(Side.Right:c_int == CblasRight,"Enum value for Side.Right does not agree with CblasRight");
-    }
-
     extern proc cblas_sdsdot (N: c_int, alpha: c_float, X: []c_float, incX: c_int, Y: []c_float, incY: c_int): c_float;
     extern proc cblas_dsdot (N: c_int, X: []c_float, incX: c_int, Y: []c_float, incY: c_int): c_double;
     extern proc cblas_sdot (N: c_int, X: []c_float, incX: c_int, Y: []c_float, incY: c_int): c_float;
@@ -33,6 +33,11 @@ In order to compile a Chapel program with this module, be sure
 to have a BLAS implementation available on your system. See the :mod:`BLAS`
 documentation for further details.
 
+Programs may instead be compiled with ``-snoBLAS=true`` (see
+:param:`BLAS.noBLAS`), in which case all operations use this module's
+native Chapel implementations.  These are also used for element types that
+BLAS does not support, such as integers.
+
 
 Linear Algebra API
 ------------------
@@ -114,12 +119,67 @@ and return a new array:
 
 Promotion flattening is not expected to be an issue in future releases.
 
+Block-Distributed Matrices
+--------------------------
+
+When both operands of a matrix-matrix :proc:`dot`, or the argument of
+:proc:`transpose`, are 2D :mod:`BlockDist` arrays, the result is
+Block-distributed over the same locales as the (first) argument.  Each
+locale computes its own block of the result, copying the parts of the
+operands it needs from other locales in bulk rather than one element at a
+time.
+
+.. code-block:: chapel
+
+  use BlockDist;
+
+  const D = {1..n, 1..n} dmapped Block({1..n, 1..n});
+  var A, B: [D] real;
+  // ... fill A and B ...
+  var C = dot(A, B);      // Block-distributed like A
+  var AT = transpose(A);  // Block-distributed like A
+
+Sparse Matrices
+---------------
+
+:proc:`dot` and :proc:`transpose` also accept sparse matrices: 2D arrays
+over a sparse domain in the default layout or in the :mod:`LayoutCSR`
+layout.  A sparse matrix may be multiplied by a dense vector, a dense
+matrix, or another sparse matrix of the same layout, and a dense vector may
+be multiplied by a sparse matrix.  These operations work directly on the
+compressed storage, and divide rows among tasks so that each task handles
+about the same number of nonzeros.
+
+Products of two sparse matrices and transposes of sparse matrices are sparse
+matrices in the layout of the arguments; other products are dense.  The
+transpose of a CSR matrix holds the matrix in compressed sparse column (CSC)
+form.
+
+.. code-block:: chapel
+
+  use LayoutCSR;
+
+  const D = {1..n, 1..n};
+  var AD: sparse subdomain(D) dmapped CSR();
+  // ... add indices to AD ...
+  var A: [AD] real;
+
+  var x: [1..n] real = 1.0;
+  var y = dot(A, x);      // sparse matrix-vector product
+  var AT = transpose(A);  // CSC form of A
+  var B = dot(A, AT);     // sparse matrix-matrix product
+
 */
 
 module LinearAlgebra {
 
  use Norm; // TODO -- merge Norm into LinearAlgebra
  use BLAS;
+ // Only for qualified names: functions that build Block or CSR values
+ // use these modules themselves, so that their names stay out of the
+ // scope of programs that use LinearAlgebra
+ use BlockDist only;
+ use LayoutCSR only;
 // use LAPACK; // TODO -- Use LAPACK routines
 
 
@@ -311,8 +371,10 @@ proc _array.T where this.domain.rank == 1 { return transpose(this); }
       a vector to this function will return that vector unchanged
 
 */
-proc transpose(A: [?Dom] ?eltType) where Dom.rank == 2 {
-  if !isBLASType(eltType) then
+proc transpose(A: [?Dom] ?eltType) where Dom.rank == 2 && !isSparseArr(A) {
+  if _isBlockMatrix(A._value) then
+    return _transposeBlock(A);
+  else if !_useBLAS(eltType) then
     return _transpose(A);
   else if Dom.shape(1) == 1 then
     return reshape(A, transpose(Dom));
@@ -370,7 +432,9 @@ proc matMinus(A: [?Adom] ?eltType, B: [?Bdom] eltType) {
     computes ``dot(transpose(A), B)``, which may not be as efficient as
     passing ``A`` and ``B`` in the reverse order.
 */
-proc dot(A: [?Adom] ?eltType, B: [?Bdom] eltType) {
+proc dot(A: [?Adom] ?eltType, B: [?Bdom] eltType)
+  where !isSparseArr(A) && !isSparseArr(B)
+{
   // vector-vector
   if Adom.rank == 1 && Bdom.rank == 1 then
     return inner(A, B);
@@ -404,8 +468,12 @@ private proc matMult(A: [?Adom] ?eltType, B: [?Bdom] eltType) {
   else if Adom.rank == 1 && Bdom.rank == 2 then
     return _matvecMult(B, A, trans=true);
   // matrix-matrix
-  else if Adom.rank == 2 && Bdom.rank == 2 then
-    return _matmatMult(A, B);
+  else if Adom.rank == 2 && Bdom.rank == 2 {
+    if _isBlockMatrix(A._value) && _isBlockMatrix(B._value) then
+      return _matmatMultBlock(A, B);
+    else
+      return _matmatMult(A, B);
+  }
   else
     compilerError("Rank sizes are not 1 or 2");
 }
@@ -414,7 +482,7 @@ private proc matMult(A: [?Adom] ?eltType, B: [?Bdom] eltType) {
 pragma "no doc"
 /* matrix-vector multiplication */
 private proc _matvecMult(A: [?Adom] ?eltType, X: [?Xdom] eltType, trans=false)
-  where isBLASType(eltType)
+  where _useBLAS(eltType)
 {
   if Adom.rank != 2 || Xdom.rank != 1 then
     compilerError("Rank sizes are not 2 and 1");
@@ -442,7 +510,7 @@ private proc _matvecMult(A: [?Adom] ?eltType, X: [?Xdom] eltType, trans=false)
 pragma "no doc"
 /* matrix-matrix multiplication */
 private proc _matmatMult(A: [?Adom] ?eltType, B: [?Bdom] eltType)
-  where isBLASType(eltType)
+  where _useBLAS(eltType)
 {
   if Adom.rank != 2 || Bdom.rank != 2 then
     compilerError("Rank sizes are not 2");
@@ -479,9 +547,39 @@ proc outer(A: [?Adom] ?eltType, B: [?Bdom] eltType) {
 
 
 pragma "no doc"
-/* Generic matrix-vector multiplication */
+/* Block sizes for _gemmNative, in elements.  A packed
+   _gemmBlockK x _gemmBlockN block of B is shared by all tasks, so it
+   should fit in a shared cache; each task's packed blocks of A and C
+   should fit in its own. */
+param _gemmBlockM = 64,
+      _gemmBlockK = 128,
+      _gemmBlockN = 256;
+
+
+pragma "no doc"
+/* The size of the blocks to split 'n' elements into for a forall: at
+   most 'blockSize', but smaller when there would otherwise be fewer
+   blocks than tasks */
+private proc _taskBlockSize(n: int, param blockSize: int) {
+  const numTasks = if dataParTasksPerLocale == 0 then here.maxTaskPar
+                   else dataParTasksPerLocale;
+
+  if divceil(n, blockSize) >= numTasks then
+    return blockSize;
+  else
+    return max(1, divceil(n, numTasks));
+}
+
+
+pragma "no doc"
+/* Whether operations on arrays of element type 't' are handed to BLAS */
+private proc _useBLAS(type t) param return !noBLAS && isBLASType(t);
+
+
+pragma "no doc"
+/* Native matrix-vector multiplication */
 proc _matvecMult(A: [?Adom] ?eltType, X: [?Xdom] eltType, trans=false)
-  where !isBLASType(eltType)
+  where !_useBLAS(eltType)
 {
   if Adom.rank != 2 || Xdom.rank != 1 then
     compilerError("Rank sizes are not 2 and 1");
@@ -491,17 +589,38 @@ proc _matvecMult(A: [?Adom] ?eltType, X: [?Xdom] eltType, trans=false)
 
   var Y: [Ydom] eltType;
 
-  // naive algorithm
+  const (rows, cols) = (Adom.dim(1), Adom.dim(2)),
+        xInds = Xdom.dim(1);
+
   if !trans {
     if Adom.shape(2) != Xdom.shape(1) then
       halt("Mismatched shape in matrix-vector multiplication");
-    forall i in Ydom do
-      Y[i] = + reduce (A[i,..]*X[..]);
+    forall i in rows {
+      var acc: eltType;
+      for (j, xj) in zip(cols, xInds) do
+        acc += A[i, j] * X[xj];
+      Y[i] = acc;
+    }
   } else {
     if Adom.shape(1) != Xdom.shape(1) then
       halt("Mismatched shape in matrix-vector multiplication");
-    forall i in Ydom do
-      Y[i] = + reduce (A[.., i]*X[..]);
+    // Each task owns a block of Y and sweeps A by rows, so that A is read
+    // along its rows rather than down its columns.
+    const N = cols.size,
+          blockN = _taskBlockSize(N, _gemmBlockN);
+    forall jj in 0..N-1 by blockN {
+      const nb = min(blockN, N-jj);
+      const (lo, hi) = (cols.orderToIndex(jj), cols.orderToIndex(jj+nb-1)),
+            colBlock = cols[min(lo, hi)..max(lo, hi)];
+      var acc: [0..#nb] eltType;
+      for (i, xi) in zip(rows, xInds) {
+        const x = X[xi];
+        for (a, j) in zip(acc, colBlock) do
+          a += A[i, j] * x;
+      }
+      for (a, j) in zip(acc, colBlock) do
+        Y[j] = a;
+    }
   }
 
   return Y;
@@ -509,22 +628,597 @@ proc _matvecMult(A: [?Adom] ?eltType, X: [?Xdom] eltType, trans=false)
 
 
 pragma "no doc"
-/* Generic matrix-matrix multiplication */
+/* Native matrix-matrix multiplication */
 proc _matmatMult(A: [?Adom] ?eltType, B: [?Bdom] eltType)
-  where !isBLASType(eltType)
+  where !_useBLAS(eltType)
 {
+  return _matmatMultNative(A, B);
+}
+
+
+pragma "no doc"
+/* Cache-blocked matrix-matrix multiplication */
+proc _matmatMultNative(A: [?Adom] ?eltType, B: [?Bdom] eltType) {
   if Adom.rank != 2 || Bdom.rank != 2 then
     compilerError("Rank sizes are not 2 and 2");
+  if Adom.shape(2) != Bdom.shape(1) then
+    halt("Mismatched shape in matrix-matrix multiplication");
 
   var C: [Adom.dim(1), Bdom.dim(2)] eltType;
+  _gemmNative(A, B, C);
+  return C;
+}
 
-  // naive algorithm
-  forall (i,j) in C.domain do
-    C[i,j] = + reduce (A[i,..]*B[..,j]);
+
+pragma "no doc"
+/* Cache-blocked C += A*B, where C is over {A.dim(1), B.dim(2)}.
+
+   C is computed one block of B at a time.  The block is packed into
+   contiguous row-major storage, then each task packs a block of rows of A,
+   accumulates their product into a contiguous block of C, and adds that to
+   C.  The blocks of rows are smaller when A has too few rows to give each
+   task one.  The innermost loop thus runs with unit stride over packed storage
+   whatever the domains of A, B and C, and is simple enough for the back-end
+   compiler to vectorize. */
+proc _gemmNative(A: [?Adom] ?eltType, B: [?Bdom] eltType, ref C: [] eltType) {
+  const (aRows, aCols) = (Adom.dim(1), Adom.dim(2)),
+        (bRows, bCols) = (Bdom.dim(1), Bdom.dim(2));
+  const M = aRows.size, K = aCols.size, N = bCols.size;
+  const blockM = _taskBlockSize(M, _gemmBlockM);
+
+  var Bp: [0..#_gemmBlockK*_gemmBlockN] eltType;
+
+  for jj in 0..N-1 by _gemmBlockN {
+    const nb = min(_gemmBlockN, N-jj);
+    for kk in 0..K-1 by _gemmBlockK {
+      const kb = min(_gemmBlockK, K-kk);
+
+      forall k in 0..#kb {
+        const bi = bRows.orderToIndex(kk+k);
+        for j in 0..#nb do
+          Bp[k*nb + j] = B[bi, bCols.orderToIndex(jj+j)];
+      }
+
+      forall ii in 0..M-1 by blockM {
+        const mb = min(blockM, M-ii);
+        var Ap: [0..#mb*kb] eltType,
+            Cp: [0..#mb*nb] eltType;
+
+        for i in 0..#mb {
+          const ai = aRows.orderToIndex(ii+i);
+          for k in 0..#kb do
+            Ap[i*kb + k] = A[ai, aCols.orderToIndex(kk+k)];
+        }
+
+        for i in 0..#mb {
+          const cOff = i*nb;
+          for k in 0..#kb {
+            const a = Ap[i*kb + k],
+                  bOff = k*nb;
+            for j in 0..#nb do
+              Cp[cOff + j] += a * Bp[bOff + j];
+          }
+        }
+
+        for i in 0..#mb {
+          const ci = aRows.orderToIndex(ii+i);
+          for j in 0..#nb do
+            C[ci, bCols.orderToIndex(jj+j)] += Cp[i*nb + j];
+        }
+      }
+    }
+  }
+}
+
+
+//
+// Block-distributed matrices
+//
+// Products and transposes of 2-D Block-distributed arrays are computed
+// owner-computes: each locale computes its own block of the result, which
+// is distributed over the same locales as 'A', from local copies of the
+// parts of the operands it needs.  Those copies are strided bulk gets
+// from the LocBlockArr of each locale owning a part, rather than one get
+// per element.
+//
+
+pragma "no doc"
+/* Number of columns of A (rows of B) that a locale copies at a time */
+param _blockPanelSize = 256;
+
+pragma "no doc"
+proc _isBlockMatrix(arr: BlockDist.BlockArr) param return arr.rank == 2 && !arr.stridable;
+
+pragma "no doc"
+proc _isBlockMatrix(arr) param return false;
+
+pragma "no doc"
+/* A Block-distributed domain over 'D', on the same locales as 'A' */
+proc _blockDomainLike(A: [], D: domain(2)) {
+  use BlockDist;
+  return D dmapped Block(boundingBox=D, targetLocales=A.targetLocales());
+}
+
+pragma "no doc"
+/* Copy 'region' of the Block-distributed 'A' into the local array 'dest',
+   over 'region', with one strided get from each locale owning part of it */
+proc _getBlockRegion(A: [], region: domain(2), ref dest: []) {
+  const arr = A._value;
+  for locArr in arr.locArr {
+    const overlap = locArr.locDom.myBlock[region];
+    if overlap.size > 0 then
+      dest[overlap] = locArr.myElems[overlap];
+  }
+}
+
+pragma "no doc"
+/* C += A*B for local arrays, where C is over {A.dim(1), B.dim(2)} */
+proc _gemmLocal(A: [?Adom] ?eltType, B: [?Bdom] eltType, ref C: [] eltType) {
+  if _useBLAS(eltType) then
+    gemm(A, B, C, 1:eltType, 1:eltType);
+  else
+    _gemmNative(A, B, C);
+}
+
+pragma "no doc"
+/* Block-distributed matrix-matrix multiplication (SUMMA).  Each locale
+   walks across its row band of A and down its column band of B one panel
+   at a time, accumulating the panels' product into its block of C. */
+proc _matmatMultBlock(A: [?Adom] ?eltType, B: [?Bdom] eltType) {
+  use BlockDist;
+
+  if Adom.shape(2) != Bdom.shape(1) then
+    halt("Mismatched shape in matrix-matrix multiplication");
+
+  const rows = Adom.dim(1), inner = Adom.dim(2), cols = Bdom.dim(2);
+  const bOff = Bdom.dim(1).low - inner.low;
+
+  var C: [_blockDomainLike(A, {rows, cols})] eltType;
+
+  // By target locale position, since a locale may appear more than once
+  const targetLocs = C.targetLocales();
+
+  coforall locIdx in targetLocs.domain do on targetLocs[locIdx] {
+    const mySub = C._value.dom.locDoms[locIdx].myBlock;
+
+    if mySub.size > 0 {
+      const (myRows, myCols) = (mySub.dim(1), mySub.dim(2));
+      var myC: [mySub] eltType;
+
+      for k in inner by _blockPanelSize {
+        const panel = k..min(k + _blockPanelSize - 1, inner.high);
+        const bPanel = panel.translate(bOff);
+        var myA: [myRows, panel] eltType,
+            myB: [bPanel, myCols] eltType;
+        _getBlockRegion(A, myA.domain, myA);
+        _getBlockRegion(B, myB.domain, myB);
+        _gemmLocal(myA, myB, myC);
+      }
+
+      C.localSlice(mySub) = myC;
+    }
+  }
 
   return C;
 }
 
+pragma "no doc"
+/* Block-distributed transpose.  Each locale copies the block of A that
+   transposes onto its block of the result, and transposes it locally. */
+proc _transposeBlock(A: [?Dom] ?eltType) {
+  use BlockDist;
+
+  var C: [_blockDomainLike(A, {Dom.dim(2), Dom.dim(1)})] eltType;
+  const targetLocs = C.targetLocales();
+
+  coforall locIdx in targetLocs.domain do on targetLocs[locIdx] {
+    const mySub = C._value.dom.locDoms[locIdx].myBlock;
+
+    if mySub.size > 0 {
+      var myA: [transpose(mySub)] eltType;
+      _getBlockRegion(A, myA.domain, myA);
+      var myC: [mySub] eltType;
+
+      forall (i, j) in mySub do
+        myC[i, j] = myA[j, i];
+
+      C.localSlice(mySub) = myC;
+    }
+  }
+
+  return C;
+}
+
+
+/* Sparse matrix-vector and sparse matrix-dense matrix multiplication */
+pragma "no doc"
+proc dot(A: [?Adom] ?eltType, B: [?Bdom] eltType)
+  where isSparseArr(A) && !isSparseArr(B)
+{
+  if Adom.rank != 2 then
+    compilerError("Sparse matrices must have rank 2");
+  if Bdom.rank == 1 then
+    return _spmv(A, B);
+  else if Bdom.rank == 2 then
+    return _spmm(A, B);
+  else
+    compilerError("Rank sizes are not 1 or 2");
+}
+
+
+/* Dense vector-sparse matrix multiplication */
+pragma "no doc"
+proc dot(A: [?Adom] ?eltType, B: [?Bdom] eltType)
+  where !isSparseArr(A) && isSparseArr(B)
+{
+  if Adom.rank != 1 || Bdom.rank != 2 then
+    compilerError("Only dense vector-sparse matrix products are supported");
+  // x^T * B == B^T * x; the transpose keeps the product row-parallel
+  return _spmv(transpose(B), A);
+}
+
+
+/* Sparse matrix-sparse matrix multiplication */
+pragma "no doc"
+proc dot(A: [?Adom] ?eltType, B: [?Bdom] eltType)
+  where isSparseArr(A) && isSparseArr(B)
+{
+  if Adom.rank != 2 || Bdom.rank != 2 then
+    compilerError("Sparse matrices must have rank 2");
+  if _isCSRDom(Adom._value) != _isCSRDom(Bdom._value) then
+    compilerError("Sparse matrix products require matching layouts");
+  return _spgemm(A, B);
+}
+
+
+/* Transpose a sparse matrix.  A CSR matrix is transposed into a CSR
+   matrix over the transposed parent domain, i.e. the CSC form of ``A``. */
+pragma "no doc"
+proc transpose(A: [?Dom] ?eltType) where isSparseArr(A) {
+  if Dom.rank != 2 then
+    compilerError("Sparse matrices must have rank 2");
+  return _sparseTranspose(A);
+}
+
+
+//
+// Sparse kernels
+//
+// These work on the storage of the CSR and default sparse layouts
+// directly: for a row 'r', the nonzeros are at positions
+// rowStart[r]..rowStart[r+1]-1 of the layout's index and data arrays.
+// CSR keeps 'rowStart' itself; for the default layout it is computed
+// up front.  Rows are divided among tasks so that each gets about the same
+// number of nonzeros, which matters for matrices with uneven row lengths.
+//
+
+pragma "no doc"
+proc _isCSRDom(dom: LayoutCSR.CSRDom) param return true;
+
+pragma "no doc"
+proc _isCSRDom(dom: DefaultSparseDom) param return false;
+
+pragma "no doc"
+proc _isCSRDom(dom) param {
+  compilerError("Sparse linear algebra supports only the default sparse and CSR layouts");
+  return false;
+}
+
+pragma "no doc"
+/* Column of the nonzero at position 'p' */
+inline proc _colAt(dom: LayoutCSR.CSRDom, p) return dom.colIdx[p];
+
+pragma "no doc"
+inline proc _colAt(dom: DefaultSparseDom, p) return dom.indices[p](2);
+
+pragma "no doc"
+/* Row starts for a default sparse domain, whose indices are sorted */
+proc _defaultSparseRowStarts(dom: DefaultSparseDom) {
+  const rows = dom.parentDom.dim(1);
+  const nnz = dom.nnz;
+  var rowStart: [rows.low..rows.high+1] dom.idxType;
+
+  forall r in rowStart.domain {
+    // first position whose row is >= r
+    var lo = 1, hi = nnz + 1;
+    while lo < hi {
+      const mid = (lo + hi) / 2;
+      if dom.indices[mid](1) < r then lo = mid + 1; else hi = mid;
+    }
+    rowStart[r] = lo: dom.idxType;
+  }
+  return rowStart;
+}
+
+pragma "no doc"
+/* Split 'rows' into 'numChunks' runs holding about the same number of
+   nonzeros.  Chunk 'c' covers rows bounds[c]..bounds[c+1]-1. */
+proc _rowChunks(rowStart, rows: range, numChunks: int) {
+  var bounds: [0..numChunks] rows.idxType;
+  const first = rowStart[rows.low],
+        nnz = rowStart[rows.high+1] - first;
+
+  bounds[0] = rows.low;
+  bounds[numChunks] = rows.high + 1;
+  forall c in 1..numChunks-1 {
+    const target = first + (nnz * c / numChunks): rowStart.eltType;
+    var lo = rows.low, hi = rows.high + 1;
+    while lo < hi {
+      const mid = (lo + hi) / 2;
+      if rowStart[mid] < target then lo = mid + 1; else hi = mid;
+    }
+    bounds[c] = lo;
+  }
+  return bounds;
+}
+
+pragma "no doc"
+proc _spmv(A: [?Adom] ?eltType, X: [?Xdom] eltType) {
+  const dom = Adom._value;
+  if _isCSRDom(dom) {
+    return _spmvKernel(A, X, dom.rowStart);
+  } else {
+    const rowStart = _defaultSparseRowStarts(dom);
+    return _spmvKernel(A, X, rowStart);
+  }
+}
+
+pragma "no doc"
+proc _spmvKernel(A: [?Adom] ?eltType, X: [?Xdom] eltType, const ref rowStart) {
+  const dom = Adom._value;
+  const rows = dom.parentDom.dim(1),
+        cols = dom.parentDom.dim(2);
+
+  if cols.size != Xdom.dim(1).size then
+    halt("Mismatched shape in matrix-vector multiplication");
+
+  var Y: [rows] eltType;
+
+  const nnz = dom.nnz;
+  if nnz == 0 then return Y;
+
+  const xOff = Xdom.dim(1).low - cols.low;
+  const ref data = A._value.data;
+  const numChunks = _computeNumChunks(nnz);
+  const bounds = _rowChunks(rowStart, rows, numChunks);
+
+  coforall c in 0..#numChunks {
+    for r in bounds[c]..bounds[c+1]-1 {
+      var acc: eltType;
+      for p in rowStart[r]..rowStart[r+1]-1 do
+        acc += data[p] * X[_colAt(dom, p) + xOff];
+      Y[r] = acc;
+    }
+  }
+
+  return Y;
+}
+
+pragma "no doc"
+proc _spmm(A: [?Adom] ?eltType, B: [?Bdom] eltType) {
+  const dom = Adom._value;
+  if _isCSRDom(dom) {
+    return _spmmKernel(A, B, dom.rowStart);
+  } else {
+    const rowStart = _defaultSparseRowStarts(dom);
+    return _spmmKernel(A, B, rowStart);
+  }
+}
+
+pragma "no doc"
+proc _spmmKernel(A: [?Adom] ?eltType, B: [?Bdom] eltType, const ref rowStart) {
+  const dom = Adom._value;
+  const rows = dom.parentDom.dim(1),
+        inner = dom.parentDom.dim(2),
+        cols = Bdom.dim(2);
+
+  if inner.size != Bdom.dim(1).size then
+    halt("Mismatched shape in matrix-matrix multiplication");
+
+  var C: [rows, cols] eltType;
+
+  const nnz = dom.nnz;
+  if nnz == 0 then return C;
+
+  const bOff = Bdom.dim(1).low - inner.low;
+  const ref data = A._value.data;
+  const numChunks = _computeNumChunks(nnz);
+  const bounds = _rowChunks(rowStart, rows, numChunks);
+
+  // each row of C is a sum of rows of B scaled by the row's nonzeros
+  coforall c in 0..#numChunks {
+    for r in bounds[c]..bounds[c+1]-1 {
+      for p in rowStart[r]..rowStart[r+1]-1 {
+        const a = data[p],
+              k = _colAt(dom, p) + bOff;
+        for j in cols do
+          C[r, j] += a * B[k, j];
+      }
+    }
+  }
+
+  return C;
+}
+
+pragma "no doc"
+proc _spgemm(A: [?Adom] ?eltType, B: [?Bdom] eltType) {
+  const adom = Adom._value, bdom = Bdom._value;
+  if _isCSRDom(adom) {
+    return _spgemmKernel(A, B, adom.rowStart, bdom.rowStart);
+  } else {
+    const aRowStart = _defaultSparseRowStarts(adom),
+          bRowStart = _defaultSparseRowStarts(bdom);
+    return _spgemmKernel(A, B, aRowStart, bRowStart);
+  }
+}
+
+pragma "no doc"
+/* Row-by-row (Gustavson) sparse matrix product.  A symbolic pass counts
+   the nonzeros of each row of C so that the numeric pass can write every
+   row into place without synchronization. */
+proc _spgemmKernel(A: [?Adom] ?eltType, B: [?Bdom] eltType,
+                   const ref aRowStart, const ref bRowStart) {
+  use Sort;
+
+  const adom = Adom._value, bdom = Bdom._value;
+  const rows = adom.parentDom.dim(1),
+        inner = adom.parentDom.dim(2),
+        cols = bdom.parentDom.dim(2);
+  type idxType = adom.idxType;
+
+  if inner.size != bdom.parentDom.dim(1).size then
+    halt("Mismatched shape in matrix-matrix multiplication");
+
+  const bOff = bdom.parentDom.dim(1).low - inner.low;
+  const ref aData = A._value.data,
+            bData = B._value.data;
+  const numChunks = max(1, _computeNumChunks(adom.nnz + bdom.nnz));
+  const bounds = _rowChunks(aRowStart, rows, numChunks);
+
+  // symbolic pass: count the distinct columns of each row of C
+  var rowCount: [rows] int;
+  coforall c in 0..#numChunks {
+    var marker: [cols] idxType = rows.low - 1;
+    for r in bounds[c]..bounds[c+1]-1 {
+      var count = 0;
+      for p in aRowStart[r]..aRowStart[r+1]-1 {
+        const k = _colAt(adom, p) + bOff;
+        for q in bRowStart[k]..bRowStart[k+1]-1 {
+          const j = _colAt(bdom, q);
+          if marker[j] != r {
+            marker[j] = r;
+            count += 1;
+          }
+        }
+      }
+      rowCount[r] = count;
+    }
+  }
+
+  var cRowStart: [rows.low..rows.high+1] int;
+  cRowStart[rows.low] = 1;
+  for r in rows do
+    cRowStart[r+1] = cRowStart[r] + rowCount[r];
+  const nnz = cRowStart[rows.high+1] - 1;
+
+  // numeric pass: accumulate each row densely, then emit it sorted
+  var inds: [1..nnz] 2*idxType;
+  var vals: [1..nnz] eltType;
+  coforall c in 0..#numChunks {
+    var acc: [cols] eltType;
+    var marker: [cols] idxType = rows.low - 1;
+    var rowCols: [0..#cols.size] idxType;
+    for r in bounds[c]..bounds[c+1]-1 {
+      var count = 0;
+      for p in aRowStart[r]..aRowStart[r+1]-1 {
+        const a = aData[p],
+              k = _colAt(adom, p) + bOff;
+        for q in bRowStart[k]..bRowStart[k+1]-1 {
+          const j = _colAt(bdom, q);
+          if marker[j] != r {
+            marker[j] = r;
+            rowCols[count] = j;
+            count += 1;
+          }
+          acc[j] += a * bData[q];
+        }
+      }
+      if count > 1 then
+        sort(rowCols[0..#count]);
+      var pos = cRowStart[r];
+      for j in rowCols[0..#count] {
+        inds[pos] = (r, j);
+        vals[pos] = acc[j];
+        acc[j] = 0: eltType;
+        pos += 1;
+      }
+    }
+  }
+
+  return _sparseFromSorted(adom, {rows, cols}, inds, vals);
+}
+
+pragma "no doc"
+/* Transpose by counting the nonzeros in each column (per chunk of rows),
+   then scattering the entries into place in column-major order. */
+proc _sparseTranspose(A: [?Adom] ?eltType) {
+  const dom = Adom._value;
+  if _isCSRDom(dom) {
+    return _sparseTransposeKernel(A, dom.rowStart);
+  } else {
+    const rowStart = _defaultSparseRowStarts(dom);
+    return _sparseTransposeKernel(A, rowStart);
+  }
+}
+
+pragma "no doc"
+proc _sparseTransposeKernel(A: [?Adom] ?eltType, const ref rowStart) {
+  const dom = Adom._value;
+  const rows = dom.parentDom.dim(1),
+        cols = dom.parentDom.dim(2);
+  type idxType = dom.idxType;
+
+  const nnz = dom.nnz;
+  const ref data = A._value.data;
+  const numChunks = max(1, _computeNumChunks(nnz));
+  const bounds = _rowChunks(rowStart, rows, numChunks);
+
+  // offsets[c, j] is where chunk 'c' writes its next entry in column 'j'
+  var offsets: [0..#numChunks, cols] int;
+  coforall c in 0..#numChunks do
+    for p in rowStart[bounds[c]]..rowStart[bounds[c+1]]-1 do
+      offsets[c, _colAt(dom, p)] += 1;
+
+  var next = 1;
+  for j in cols {
+    for c in 0..#numChunks {
+      const count = offsets[c, j];
+      offsets[c, j] = next;
+      next += count;
+    }
+  }
+
+  var inds: [1..nnz] 2*idxType;
+  var vals: [1..nnz] eltType;
+  coforall c in 0..#numChunks {
+    for r in bounds[c]..bounds[c+1]-1 {
+      for p in rowStart[r]..rowStart[r+1]-1 {
+        const j = _colAt(dom, p);
+        const pos = offsets[c, j];
+        offsets[c, j] = pos + 1;
+        inds[pos] = (j, r);
+        vals[pos] = data[p];
+      }
+    }
+  }
+
+  return _sparseFromSorted(dom, {cols, rows}, inds, vals);
+}
+
+pragma "no doc"
+/* Build a sparse matrix with the layout of 'dom' from sorted, unique
+   indices and their values */
+proc _sparseFromSorted(dom, parentDom, inds, vals) {
+  use LayoutCSR;
+
+  const nnz = inds.size;
+  if _isCSRDom(dom) {
+    var D: sparse subdomain(parentDom) dmapped CSR();
+    D.bulkAdd(inds, dataSorted=true, isUnique=true, preserveInds=false);
+    var M: [D] vals.eltType;
+    forall p in 1..nnz do
+      M._value.data[p] = vals[p];
+    return M;
+  } else {
+    var D: sparse subdomain(parentDom);
+    D.bulkAdd(inds, dataSorted=true, isUnique=true, preserveInds=false);
+    var M: [D] vals.eltType;
+    forall p in 1..nnz do
+      M._value.data[p] = vals[p];
+    return M;
+  }
+}
+
 
 /* Return the matrix ``A`` to the ``bth`` power, where ``b`` is a positive
    integral type. */
@@ -269,13 +269,88 @@ proc chpl_check_comparator(comparator, type eltType) {
 }
 
 
+pragma "no doc"
+/*
+   The type that :proc:`radixSort` orders elements of type `eltType` by:
+   the element type itself for the default comparator, the return type of
+   ``comparator.key(a)`` for key comparators, and ``void`` otherwise.
+ */
+proc chpl_radixKeyType(comparator, type eltType) type {
+  use Reflection;
+
+  var data: eltType;
+
+  if comparator.type == DefaultComparator then
+    return eltType;
+  else if canResolveMethod(comparator, "key", data) then
+    return comparator.key(data).type;
+  else
+    return void;
+}
+
+
+pragma "no doc"
+/* Can :proc:`radixSort` sort elements of type `eltType` by `comparator`? */
+proc chpl_radixSortable(comparator, type eltType) param {
+  type keyType = chpl_radixKeyType(comparator, eltType);
+
+  return isIntegralType(keyType) || isRealType(keyType);
+}
+
+
+pragma "no doc"
+/*
+   Map the radix sort key of `a` to an unsigned integer that orders the
+   same way: flip the sign bit of signed integers, and flip the sign bit of
+   non-negative reals and every bit of negative ones.
+ */
+inline proc chpl_radixKeyBits(a, comparator): uint(64) {
+  const k = if comparator.type == DefaultComparator then a
+            else comparator.key(a);
+  type keyType = k.type;
+
+  if isUintType(keyType) {
+    return k: uint(64);
+  } else if isIntType(keyType) {
+    param bits = numBits(keyType);
+    return ((k: uint(bits)) ^ (1: uint(bits) << (bits-1))): uint(64);
+  } else {
+    const b = __primitive("real2int", k: real(64)): uint(64);
+    return if (b >> 63) == 1 then ~b else b | (1: uint(64) << 63);
+  }
+}
+
+
+pragma "no doc"
+/*
+   Arrays shorter than this are handed to :proc:`quickSort` by the parallel
+   sorts, and each task of a parallel sort gets at least this many elements.
+ */
+private param chpl_parSortMinLength = 1 << 14;
+
+
+pragma "no doc"
+/* The number of tasks to sort `n` elements with. */
+proc chpl_parSortNumTasks(n: int): int {
+  const maxTasks = if dataParTasksPerLocale == 0 then here.maxTaskPar
+                   else dataParTasksPerLocale;
+
+  return max(1, min(maxTasks, n / chpl_parSortMinLength));
+}
+
+
 /* Basic Functions */
 
 /*
    General purpose sorting interface.
 
-   .. note:: Currently this method calls a sequential :proc:`quickSort`, but
-             this may change the future as other algorithms are implemented.
+   .. note:: This method calls the parallel :proc:`radixSort` when the
+             elements, or the keys returned by the comparator's ``key``
+             method, are integral or real values, and the parallel
+             :proc:`sampleSort` otherwise.  Block-distributed arrays are
+             sorted with a distributed sample sort that sorts each
+             locale's block with one of those and moves elements between
+             locales in bulk.
 
    :arg Data: The array to be sorted
    :type Data: [] `eltType`
@@ -284,7 +359,14 @@ proc chpl_check_comparator(comparator, type eltType) {
 
  */
 proc sort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator) {
-  quickSort(Data, comparator=comparator);
+  chpl_check_comparator(comparator, eltType);
+
+  if Data._value.doiCanSortDistributed() then
+    _DistributedSort(Data, comparator);
+  else if chpl_radixSortable(comparator, eltType) then
+    radixSort(Data, comparator=comparator);
+  else
+    sampleSort(Data, comparator=comparator);
 }
 
 
@@ -296,6 +378,235 @@ proc sort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator)
 }
 
 
+/*
+   Sort a distributed array whose locales each own one contiguous block of
+   indices (see BaseArr.doiCanSortDistributed()) in place:
+
+   1. each locale copies its block into a local buffer and sorts it,
+   2. evenly spaced samples of the sorted buffers choose one splitter
+      between each pair of consecutive locales,
+   3. each locale pulls the elements between its splitters from every
+      locale's buffer, one bulk get per locale, and merges those runs,
+   4. each locale pulls the elements whose sorted positions fall in its
+      own block back into the array.
+ */
+private proc _DistributedSort(Data: [?Dom] ?eltType, comparator) {
+  const targetLocs = Data.targetLocales(),
+        numLocs = targetLocs.size,
+        n = Dom.size;
+
+  // Not worth spreading out: sort a local copy
+  if numLocs == 1 || n < numLocs * chpl_parSortMinLength {
+    var Local: [0..#n] eltType = Data;
+    sort(Local, comparator=comparator);
+    Data = Local;
+    return;
+  }
+
+  const samplesPerLoc = max(16, numLocs);
+  var Bufs: [0..#numLocs] _DistSortBuffer(eltType);
+  var Samples: [0..#numLocs*samplesPerLoc] eltType;
+  var numSamples: [0..#numLocs] int;
+
+  // 1. Sort each block locally and take samples from it
+  coforall (loc, i) in zip(targetLocs, 0..) do on loc {
+    const mySub = Data._value.doiTargetBlock(i);
+    const buf = new _DistSortBuffer(eltType, numLocs, mySub.size);
+
+    buf.Elems = Data.localSlice(mySub);
+    sort(buf.Elems, comparator=comparator);
+
+    if mySub.size > 0 {
+      var mySamples: [0..#samplesPerLoc] eltType;
+
+      for s in 0..#samplesPerLoc do
+        mySamples[s] = buf.Elems[s * mySub.size / samplesPerLoc];
+
+      Samples[i*samplesPerLoc..#samplesPerLoc] = mySamples;
+      numSamples[i] = samplesPerLoc;
+    }
+
+    Bufs[i] = buf;
+  }
+
+  // 2. Choose the splitters
+  var AllSamples: [0..#(+ reduce numSamples)] eltType;
+  var next = 0;
+
+  for i in 0..#numLocs {
+    for s in 0..#numSamples[i] {
+      AllSamples[next] = Samples[i*samplesPerLoc + s];
+      next += 1;
+    }
+  }
+
+  quickSort(AllSamples, comparator=comparator);
+
+  var Splitters: [0..#numLocs-1] eltType;
+
+  for j in 0..#numLocs-1 do
+    Splitters[j] = AllSamples[(j + 1) * AllSamples.size / numLocs];
+
+  coforall (loc, i) in zip(targetLocs, 0..) do on loc {
+    const buf = Bufs[i];
+    const mySplitters = Splitters;
+
+    buf.sendStart[numLocs] = buf.numElems;
+
+    for j in 1..numLocs-1 do
+      buf.sendStart[j] = _LowerBound(buf.Elems, buf.sendStart[j-1],
+                                     buf.numElems, mySplitters[j-1],
+                                     comparator);
+  }
+
+  // 3. Exchange and merge
+  var recvCounts: [0..#numLocs] int;
+
+  coforall (loc, j) in zip(targetLocs, 0..) do on loc {
+    const buf = Bufs[j];
+    var runStart: [0..numLocs] int;
+
+    for i in 0..#numLocs {
+      const other = Bufs[i];
+      runStart[i+1] = runStart[i] + other.sendStart[j+1] - other.sendStart[j];
+    }
+
+    buf.recvDom = {0..#runStart[numLocs]};
+
+    forall i in 0..#numLocs {
+      const other = Bufs[i];
+      const first = other.sendStart[j],
+            last = other.sendStart[j+1] - 1;
+
+      if last >= first then
+        buf.Recv[runStart[i]..#(last - first + 1)] = other.Elems[first..last];
+    }
+
+    var inScratch = false;
+    var width = 1;
+
+    while width < numLocs {
+      if inScratch then
+        _MergeRuns(buf.Scratch, buf.Recv, runStart, width, comparator);
+      else
+        _MergeRuns(buf.Recv, buf.Scratch, runStart, width, comparator);
+      inScratch = !inScratch;
+      width *= 2;
+    }
+
+    if inScratch then
+      buf.Recv = buf.Scratch;
+
+    recvCounts[j] = runStart[numLocs];
+  }
+
+  // 4. Move the sorted elements back into the blocks
+  var globalStart: [0..numLocs] int;
+
+  for j in 0..#numLocs do
+    globalStart[j+1] = globalStart[j] + recvCounts[j];
+
+  coforall (loc, i) in zip(targetLocs, 0..) do on loc {
+    const mySub = Data._value.doiTargetBlock(i);
+    const myStarts = globalStart;
+
+    if mySub.size > 0 {
+      const myFirst = mySub.low - Dom.low,
+            myLast = mySub.high - Dom.low;
+
+      forall j in 0..#numLocs {
+        const first = max(myFirst, myStarts[j]),
+              last = min(myLast, myStarts[j+1] - 1);
+
+        if last >= first then
+          Data.localSlice(Dom.low + first..Dom.low + last) =
+            Bufs[j].Recv[first - myStarts[j]..last - myStarts[j]];
+      }
+    }
+  }
+
+  coforall (loc, i) in zip(targetLocs, 0..) do on loc do
+    delete Bufs[i];
+}
+
+
+pragma "no doc"
+/* One locale's working storage for _DistributedSort(). */
+class _DistSortBuffer {
+  type eltType;
+  const numLocs: int;
+  const numElems: int;
+
+  // This locale's sorted block, and where the part of it bound for each
+  // locale starts
+  var Elems: [0..#numElems] eltType;
+  var sendStart: [0..numLocs] int;
+
+  // The elements received from all locales, and merge space for them
+  var recvDom: domain(1);
+  var Recv: [recvDom] eltType;
+  var Scratch: [recvDom] eltType;
+}
+
+
+/*
+   Returns the first position in Data[first..last-1], which is sorted, whose
+   element is not less than x, or last if there is none.
+ */
+private proc _LowerBound(Data, in first: int, in last: int, x, comparator) {
+  while first < last {
+    const mid = first + (last - first) / 2;
+
+    if chpl_compare(Data[mid], x, comparator) < 0 then
+      first = mid + 1;
+    else
+      last = mid;
+  }
+
+  return first;
+}
+
+
+/*
+   One round of merging the sorted runs of Src into Dst, where run r is
+   Src[runStart[r]..runStart[r+1]-1].  The previous rounds have merged
+   each group of 'width' runs into one; this round merges neighbouring
+   groups pairwise, in parallel.
+ */
+private proc _MergeRuns(Src, Dst, runStart, width, comparator) {
+  const numRuns = runStart.size - 1;
+
+  forall r1 in 0..numRuns-1 by 2*width {
+    const r2 = min(r1 + width, numRuns),
+          r3 = min(r1 + 2*width, numRuns);
+    var i = runStart[r1],
+        j = runStart[r2],
+        k = runStart[r1];
+
+    while i < runStart[r2] && j < runStart[r3] {
+      if chpl_compare(Src[j], Src[i], comparator) < 0 {
+        Dst[k] = Src[j];
+        j += 1;
+      } else {
+        Dst[k] = Src[i];
+        i += 1;
+      }
+      k += 1;
+    }
+
+    for p in i..runStart[r2]-1 {
+      Dst[k] = Src[p];
+      k += 1;
+    }
+
+    for p in j..runStart[r3]-1 {
+      Dst[k] = Src[p];
+      k += 1;
+    }
+  }
+}
+
+
 /*
    Check if array `Data` is in sorted order
 
@@ -595,8 +906,8 @@ proc quickSort(Data: [?Dom] ?eltType, minlen=16, comparator:?rec=defaultComparat
   chpl_check_comparator(comparator, eltType);
   // grab obvious indices
   const stride = abs(Dom.stride),
-        lo = Dom.low,
-        hi = Dom.high,
+        lo = Dom.dim(1).alignedLow,
+        hi = Dom.dim(1).alignedHigh,
         size = Dom.size,
         mid = if hi == lo then hi
               else if size % 2 then lo + ((size - 1)/2) * stride
@@ -636,8 +947,8 @@ proc quickSort(Data: [?Dom] ?eltType, minlen=16, comparator:?rec=defaultComparat
 
   // TODO -- Get this cobegin working and tested
   //  cobegin {
-    quickSort(Data[..loptr-stride], minlen, comparator);  // could use unbounded ranges here
-    quickSort(Data[loptr+stride..], minlen, comparator);
+    quickSort(Data[lo..loptr-stride by stride], minlen, comparator);
+    quickSort(Data[loptr+stride..hi by stride], minlen, comparator);
   //  }
 }
 
@@ -700,6 +1011,265 @@ proc quickSort(Data: [?Dom] ?eltType, minlen=16, comparator:?rec=defaultComparat
 }
 
 
+/*
+   Sort the 1D array `Data` in-place using a parallel least-significant-digit
+   radix sort.  The elements must be integral or real values, or the
+   comparator must have a ``key`` method that returns one.  Arrays shorter
+   than 16384 elements are sorted with :proc:`quickSort`.
+
+   :arg Data: The array to be sorted
+   :type Data: [] `eltType`
+   :arg comparator: :ref:`Comparator <comparators>` record that defines how the
+      data is sorted.
+
+ */
+proc radixSort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator) {
+  chpl_check_comparator(comparator, eltType);
+
+  if !chpl_radixSortable(comparator, eltType) then
+    compilerError("radixSort() requires integral or real keys");
+
+  type keyType = chpl_radixKeyType(comparator, eltType);
+  param radix = 256,
+        numPasses = if isRealType(keyType) then 8 else numBytes(keyType);
+
+  const n = Dom.size,
+        lo = Dom.dim(1).alignedLow,
+        stride = if Dom.stridable then abs(Dom.stride) else 1;
+
+  if n < chpl_parSortMinLength {
+    quickSort(Data, comparator=comparator);
+    return;
+  }
+
+  const numTasks = chpl_parSortNumTasks(n);
+  var Scratch: [Dom] eltType;
+  var counts, offsets: [0..#numTasks, 0..#radix] int;
+  var inScratch = false;
+
+  for pass in 0..#numPasses {
+    const shift = (8 * pass): uint(64);
+    const moved = if inScratch then radixPass(Scratch, Data, shift)
+                  else radixPass(Data, Scratch, shift);
+    if moved then
+      inScratch = !inScratch;
+  }
+
+  if inScratch then
+    forall i in Dom do
+      Data[i] = Scratch[i];
+
+  // Stably move the elements of Src into Dst ordered by the digit of
+  // their key at 'shift'.  Returns false, without moving anything, when
+  // every element has the same digit.
+  proc radixPass(Src, Dst, shift: uint(64)): bool {
+    inline proc digit(a) {
+      return ((chpl_radixKeyBits(a, comparator) >> shift) & (radix-1)): int;
+    }
+
+    coforall tid in 0..#numTasks {
+      const first = tid * n / numTasks,
+            last = (tid + 1) * n / numTasks - 1;
+      var myCounts: [0..#radix] int;
+
+      for p in first..last do
+        myCounts[digit(Src[lo + p*stride])] += 1;
+
+      counts[tid, ..] = myCounts;
+    }
+
+    var sum = 0;
+
+    for d in 0..#radix {
+      var total = 0;
+
+      for tid in 0..#numTasks {
+        offsets[tid, d] = sum;
+        sum += counts[tid, d];
+        total += counts[tid, d];
+      }
+
+      if total == n then
+        return false;
+    }
+
+    coforall tid in 0..#numTasks {
+      const first = tid * n / numTasks,
+            last = (tid + 1) * n / numTasks - 1;
+      var myOffsets: [0..#radix] int = offsets[tid, ..];
+
+      for p in first..last {
+        const d = digit(Src[lo + p*stride]);
+
+        Dst[lo + myOffsets[d]*stride] = Src[lo + p*stride];
+        myOffsets[d] += 1;
+      }
+    }
+
+    return true;
+  }
+}
+
+
+pragma "no doc"
+/* Error message for multi-dimension arrays */
+proc radixSort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator)
+  where Dom.rank != 1 {
+    compilerError("radixSort() requires 1-D array");
+}
+
+
+/*
+   Sort the 1D array `Data` in-place using a parallel sample sort.  A
+   sorted sample of the array picks splitters that divide the elements into
+   buckets; the elements are moved into their buckets in parallel, and the
+   buckets are sorted in parallel with :proc:`quickSort`.  Arrays shorter
+   than 16384 elements are sorted with :proc:`quickSort` directly.
+
+   :arg Data: The array to be sorted
+   :type Data: [] `eltType`
+   :arg comparator: :ref:`Comparator <comparators>` record that defines how the
+      data is sorted.
+
+ */
+proc sampleSort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator) {
+  chpl_check_comparator(comparator, eltType);
+
+  param bucketsPerTask = 4,
+        oversample = 16;
+
+  const n = Dom.size,
+        lo = Dom.dim(1).alignedLow,
+        stride = if Dom.stridable then abs(Dom.stride) else 1;
+
+  if n < chpl_parSortMinLength {
+    quickSort(Data, comparator=comparator);
+    return;
+  }
+
+  const numTasks = chpl_parSortNumTasks(n),
+        numSplitters = numTasks * bucketsPerTask - 1,
+        numSamples = (numSplitters + 1) * oversample;
+
+  // Take one element from each of numSamples equal slices of the array,
+  // at a position within the slice that varies from slice to slice.
+  var Samples: [0..#numSamples] eltType;
+
+  for i in 0..#numSamples {
+    const sliceLen = n / numSamples,
+          jitter = ((i * 2654435761) >> 7) % sliceLen;
+    Samples[i] = Data[lo + (i * sliceLen + jitter) * stride];
+  }
+
+  quickSort(Samples, comparator=comparator);
+
+  var Splitters: [0..#numSplitters] eltType;
+
+  for i in 0..#numSplitters do
+    Splitters[i] = Samples[(i + 1) * oversample];
+
+  // Bucket 2*i holds the elements between splitters i-1 and i, and bucket
+  // 2*i+1 the elements equal to splitter i, which need no further sorting.
+  // The equality buckets keep a heavily repeated value from swamping the
+  // bucket it would otherwise fall into.
+  const numBuckets = 2 * numSplitters + 1;
+  var Buckets: [0..#n] int(32);
+  var counts, offsets: [0..#numTasks, 0..#numBuckets] int;
+
+  proc bucketOf(a): int {
+    var first = 0,
+        last = numSplitters;
+
+    while first < last {
+      const mid = (first + last) / 2;
+
+      if chpl_compare(Splitters[mid], a, comparator) < 0 then
+        first = mid + 1;
+      else
+        last = mid;
+    }
+
+    if first < numSplitters &&
+       chpl_compare(a, Splitters[first], comparator) == 0 then
+      return 2 * first + 1;
+    else
+      return 2 * first;
+  }
+
+  coforall tid in 0..#numTasks {
+    const first = tid * n / numTasks,
+          last = (tid + 1) * n / numTasks - 1;
+    var myCounts: [0..#numBuckets] int;
+
+    for p in first..last {
+      const b = bucketOf(Data[lo + p*stride]);
+
+      Buckets[p] = b: int(32);
+      myCounts[b] += 1;
+    }
+
+    counts[tid, ..] = myCounts;
+  }
+
+  var bucketStart: [0..numBuckets] int;
+  var sum = 0;
+
+  for b in 0..#numBuckets {
+    bucketStart[b] = sum;
+
+    for tid in 0..#numTasks {
+      offsets[tid, b] = sum;
+      sum += counts[tid, b];
+    }
+  }
+
+  bucketStart[numBuckets] = n;
+
+  var Scratch: [0..#n] eltType;
+
+  coforall tid in 0..#numTasks {
+    const first = tid * n / numTasks,
+          last = (tid + 1) * n / numTasks - 1;
+    var myOffsets: [0..#numBuckets] int = offsets[tid, ..];
+
+    for p in first..last {
+      const b = Buckets[p];
+
+      Scratch[myOffsets[b]] = Data[lo + p*stride];
+      myOffsets[b] += 1;
+    }
+  }
+
+  // Bucket sizes vary, so let the tasks claim buckets as they finish.
+  var nextBucket: atomic int;
+
+  coforall tid in 0..#numTasks {
+    var b = nextBucket.fetchAdd(1);
+
+    while b < numBuckets {
+      const first = bucketStart[b],
+            last = bucketStart[b+1] - 1;
+
+      if b % 2 == 0 && last > first then
+        quickSort(Scratch[first..last], comparator=comparator);
+
+      for p in first..last do
+        Data[lo + p*stride] = Scratch[p];
+
+      b = nextBucket.fetchAdd(1);
+    }
+  }
+}
+
+
+pragma "no doc"
+/* Error message for multi-dimension arrays */
+proc sampleSort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator)
+  where Dom.rank != 1 {
+    compilerError("sampleSort() requires 1-D array");
+}
+
+
 /*
    Sort the 1D array `Data` in-place using a sequential selection sort
    algorithm.
@@ -0,0 +1,165 @@
+/*
+ * Copyright 2004-2017 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+   The ``StringBuilder`` module provides a record for building up a string
+   from many pieces.
+
+   Every application of ``+`` to strings allocates a buffer for its result,
+   so an expression such as ``a + ":" + i`` creates, copies and frees an
+   intermediate string for each operator, as well as a temporary string for
+   the integer.  A :record:`StringBuilder` instead appends each piece,
+   integers included, directly into a single growable buffer.  Since
+   :proc:`StringBuilder.clear` keeps that buffer, a builder that is reused
+   for many short strings stops allocating once it has grown to fit the
+   longest of them:
+
+   .. code-block:: chapel
+
+     use StringBuilder;
+
+     var sb: StringBuilder;
+     for i in 1..n {
+       sb.clear();
+       sb.append(prefix, ":", i);
+       keys[i] = sb.toString();
+     }
+
+   When the final length is known, or can be bounded, :proc:`StringBuilder.reserve`
+   allocates the buffer once up front.
+
+   The number of allocations a piece of code performs can be checked with
+   :proc:`Memory.memoryAllocations` when the program is run with
+   ``--memTrack``.
+ */
+module StringBuilder {
+
+  // Growth factor to use when extending the buffer for appends
+  private config param builderGrowthFactor = 1.5;
+
+  /*
+     A growable buffer of characters that can be turned into a string.
+   */
+  record StringBuilder {
+    pragma "no doc"
+    var buffer: string;
+
+    /*
+       Create a builder whose buffer has room for ``capacity`` bytes.
+     */
+    proc StringBuilder(capacity: int = 0) {
+      if capacity > 0 then buffer._reserve(capacity);
+    }
+
+    /* The number of bytes appended since the builder was created or last
+       cleared. */
+    inline proc length return buffer.length;
+
+    /*
+       Grow the buffer, if necessary, so that it can hold ``capacity`` bytes
+       without reallocating.
+     */
+    proc reserve(capacity: int) {
+      buffer._reserve(capacity);
+    }
+
+    /*
+       Append each of the arguments to the buffer.  Strings are copied in
+       directly and integers are formatted in place; other values are
+       first converted with a cast to ``string``.
+     */
+    proc append(args ...?k) {
+      for param i in 1..k {
+        if args(i).type == string then
+          buffer += args(i);
+        else if isIntegralType(args(i).type) then
+          appendIntegral(args(i));
+        else
+          buffer += args(i):string;
+      }
+    }
+
+    /*
+       Discard the contents of the builder.  The buffer is kept so that it
+       can be reused by later appends.
+     */
+    proc clear() {
+      buffer._truncate();
+    }
+
+    /*
+       Return a copy of the string built so far.  The builder keeps its
+       contents and its buffer.
+     */
+    proc toString(): string {
+      return new string(buffer);
+    }
+
+    pragma "no doc"
+    proc writeThis(f) {
+      f.write(buffer);
+    }
+
+    // Writes the decimal digits of x straight into the buffer, growing it
+    // geometrically like string's += does.
+    pragma "no doc"
+    proc appendIntegral(x: integral) {
+      if !_local && buffer.locale_id != chpl_nodeID {
+        buffer += x:string;
+        return;
+      }
+
+      param maxDigits = 20; // enough for any 64-bit value and its sign
+      const needed = buffer.len + maxDigits;
+      if needed >= buffer._size || !buffer.owned then
+        buffer._reserve(max(needed, buffer.len*builderGrowthFactor):int);
+
+      var digits: maxDigits*uint(8);
+      var nDigits = 0;
+      var mag: uint(64);
+      const negative = isIntType(x.type) && x < 0;
+      if negative then mag = 0:uint(64) - x:uint(64);
+      else mag = x:uint(64);
+      do {
+        nDigits += 1;
+        digits(nDigits) = (mag % 10 + 0x30):uint(8);
+        mag /= 10;
+      } while mag != 0;
+
+      var pos = buffer.len;
+      if negative {
+        buffer.buff[pos] = 0x2d; // '-'
+        pos += 1;
+      }
+      for j in 1..nDigits by -1 {
+        buffer.buff[pos] = digits(j);
+        pos += 1;
+      }
+      buffer.buff[pos] = 0;
+      buffer.len = pos;
+    }
+  }
+
+  /*
+     Append ``x`` to the builder ``sb``.
+   */
+  inline proc +=(ref sb: StringBuilder, x) {
+    sb.append(x);
+  }
+}
@@ -50,9 +50,14 @@
    "task-team" concept.  A task-team will more directly support collective
    operations such as barriers between the tasks within a team.
 
-   The current implementation is designed for correctness, but is not expected
-   to perform well at scale.  We expect performance at scale to improve as
-   this barrier implementation is optimized and as the task-team concept is
+   The `Atomic` and `Sync` implementations are designed for correctness, but
+   are not expected to perform well at scale: every task updates the same
+   variable, so a barrier among tasks on many locales costs a number of
+   remote operations on a single locale that grows with the number of tasks.
+   The `Dissemination` and `Tree` implementations first gather the tasks on
+   each locale and then synchronize only one task per locale, so each locale
+   takes part in O(log numLocales) remote operations per barrier.  We expect
+   performance at scale to improve further as the task-team concept is
    implemented and optimized.
 */
 module Barrier {
@@ -61,8 +66,24 @@ module Barrier {
 
      * `BarrierType.Atomic` uses Chapel atomic variables to control the barrier.
      * `BarrierType.Sync` uses Chapel sync variables to control the barrier.
+     * `BarrierType.Dissemination` gathers the tasks on each locale, then
+       synchronizes the locales with a dissemination barrier.
+     * `BarrierType.Tree` gathers the tasks on each locale, then synchronizes
+       the locales by combining up and releasing down a binary tree.
+
+     The `Dissemination` and `Tree` barriers expect the tasks to be spread
+     evenly over the locales: each locale runs ``numTasks/numLocales`` of
+     them, and the first ``numTasks%numLocales`` locales run one more.  This
+     is the case for SPMD-style code such as::
+
+       coforall loc in Locales do on loc do
+         coforall tid in 0..#tasksPerLocale do
+           ...
+
+     These barriers are always reusable and support :proc:`Barrier.barrier`
+     and :proc:`Barrier.reset`, but not the split-phase methods.
   */
-  enum BarrierType {Atomic, Sync}
+  enum BarrierType {Atomic, Sync, Dissemination, Tree}
 
   /* A barrier that will cause `numTasks` to wait before proceeding. */
   record Barrier {
@@ -70,6 +91,8 @@ module Barrier {
     var bar: BarrierBaseType;
     pragma "no doc"
     var owned: bool = false;
+    pragma "no doc"
+    var pid: int = nullPid; // privatized per-locale copies, if any
 
     /* Construct a new barrier object.
 
@@ -96,6 +119,18 @@ module Barrier {
             bar = new sBarrier(numTasks);
           }
         }
+        when BarrierType.Dissemination {
+          const b = new dBarrier(numTasks);
+          pid = _newPrivatizedClass(b);
+          b.link();
+          bar = b;
+        }
+        when BarrierType.Tree {
+          const b = new tBarrier(numTasks);
+          pid = _newPrivatizedClass(b);
+          b.link();
+          bar = b;
+        }
         otherwise {
           halt("unknown barrier type");
         }
@@ -106,6 +141,8 @@ module Barrier {
     pragma "no doc"
     proc deinit() {
       if owned && bar != nil {
+        if pid != nullPid then
+          _freePrivatizedClass(pid, bar);
         delete bar;
       }
     }
@@ -114,8 +151,13 @@ module Barrier {
        is true, reset the barrier to be used again.
      */
     inline proc barrier() {
-      on this {
-        bar.barrier();
+      if pid != nullPid {
+        // Start from this locale's copy, without communication.
+        chpl_getPrivatizedCopy(lBarrier, pid).barrier();
+      } else {
+        on this {
+          bar.barrier();
+        }
       }
     }
 
@@ -343,12 +385,239 @@ module Barrier {
     }
   }
 
+  /* The base class for barriers that gather the tasks on each locale before
+     synchronizing the locales.  Every locale has its own privatized copy.
+     The last of a locale's tasks to arrive runs :proc:`combine` on behalf of
+     the locale, while the others wait for the locale's episode count to
+     advance.
+   */
+  pragma "no doc" class lBarrier: BarrierBaseType {
+    pragma "no doc"
+    var pid: int = nullPid;
+    pragma "no doc"
+    var numTasks: int;
+    /* The number of locales with tasks; the first numParticipants locales */
+    pragma "no doc"
+    var numParticipants: int;
+    /* The number of tasks on this locale */
+    pragma "no doc"
+    var n: int;
+    pragma "no doc"
+    var count: atomic int;
+    /* The number of barriers this locale has completed */
+    pragma "no doc"
+    var episode: atomic int;
+
+    pragma "no doc"
+    proc setup(nTasks: int) {
+      numTasks = nTasks;
+      numParticipants = min(numLocales, nTasks);
+      n = nTasks / numLocales + (if here.id < nTasks % numLocales then 1
+                                                                  else 0);
+      count.write(n);
+      episode.write(0);
+    }
+
+    pragma "no doc"
+    proc dsiSupportsPrivatization() param return true;
+
+    pragma "no doc"
+    proc dsiGetPrivatizeData() return numTasks;
+
+    /* Set up links between the copies on different locales once all of
+       them exist.  Called on the original object.
+     */
+    pragma "no doc"
+    proc link() {
+      const pid = this.pid;
+      coforall loc in Locales do on loc do
+        chpl_getPrivatizedCopy(this.type, pid).linkLocal();
+    }
+
+    pragma "no doc"
+    proc linkLocal() {
+      halt("linkLocal() not implemented");
+    }
+
+    /* Synchronize with the other participating locales, for this locale's
+       barrier number e.
+     */
+    pragma "no doc"
+    proc combine(e: int) {
+      halt("combine() not implemented");
+    }
+
+    pragma "no doc"
+    proc barrier() {
+      const e = episode.read() + 1;
+      const myc = count.fetchSub(1);
+      if myc == 1 {
+        if numParticipants > 1 then
+          combine(e);
+        count.write(n);
+        episode.write(e);
+      } else {
+        if myc < 1 then
+          halt("Too many callers to barrier()");
+        episode.waitFor(e);
+      }
+    }
+
+    pragma "no doc"
+    proc reset(nTasks: int) {
+      const pid = this.pid;
+      coforall loc in Locales do on loc do
+        chpl_getPrivatizedCopy(this.type, pid).setup(nTasks);
+      link();
+    }
+  }
+
+  /* In round k of a dissemination barrier, locale i signals locale
+     (i + 2**k) % numParticipants and waits for the signal from locale
+     (i - 2**k) % numParticipants.  After ceil(log2(numParticipants)) rounds
+     every locale has transitively heard from every other one.  Signals are
+     counted per round, so a partner that has moved on to the next barrier
+     cannot be confused with one from this barrier.
+   */
+  pragma "no doc" class dBarrier: lBarrier {
+    pragma "no doc"
+    var roundsDom: domain(1);
+    pragma "no doc"
+    var signals: [roundsDom] atomic int;
+    pragma "no doc"
+    var partners: [roundsDom] dBarrier;
+
+    pragma "no doc"
+    proc dBarrier(nTasks: int) {
+      setup(nTasks);
+    }
+
+    pragma "no doc"
+    proc setup(nTasks: int) {
+      super.setup(nTasks);
+      var rounds = 0;
+      while 2**rounds < numParticipants do
+        rounds += 1;
+      roundsDom = {0..#rounds};
+      signals.write(0);
+      partners = nil;
+    }
+
+    pragma "no doc"
+    proc dsiPrivatize(privatizeData) {
+      return new dBarrier(privatizeData);
+    }
+
+    pragma "no doc"
+    proc linkLocal() {
+      if here.id >= numParticipants then return;
+      for k in roundsDom {
+        const partner = (here.id + 2**k) % numParticipants;
+        on Locales[partner] do
+          partners[k] = chpl_getPrivatizedCopy(dBarrier, pid);
+      }
+    }
+
+    pragma "no doc"
+    proc signal(k: int) {
+      on this do signals[k].add(1);
+    }
+
+    pragma "no doc"
+    proc combine(e: int) {
+      for k in roundsDom {
+        partners[k].signal(k);
+        while signals[k].read() < e do
+          chpl_task_yield();
+      }
+    }
+  }
+
+  /* Locales combine up a binary tree in which locale i has children 2i+1
+     and 2i+2.  The root releases its children, which release theirs.
+   */
+  pragma "no doc" class tBarrier: lBarrier {
+    pragma "no doc"
+    var parent, left, right: tBarrier;
+    pragma "no doc"
+    var numChildren: int;
+    /* The number of arrivals from children, over all barriers */
+    pragma "no doc"
+    var arrived: atomic int;
+    /* The last barrier the parent has released */
+    pragma "no doc"
+    var released: atomic int;
+
+    pragma "no doc"
+    proc tBarrier(nTasks: int) {
+      setup(nTasks);
+    }
+
+    pragma "no doc"
+    proc setup(nTasks: int) {
+      super.setup(nTasks);
+      numChildren = 0;
+      for c in 2*here.id+1..2*here.id+2 do
+        if c < numParticipants then
+          numChildren += 1;
+      arrived.write(0);
+      released.write(0);
+      parent = nil;
+      left = nil;
+      right = nil;
+    }
+
+    pragma "no doc"
+    proc dsiPrivatize(privatizeData) {
+      return new tBarrier(privatizeData);
+    }
+
+    pragma "no doc"
+    proc linkLocal() {
+      const me = here.id;
+      if me >= numParticipants then return;
+      if me > 0 then
+        on Locales[(me-1)/2] do
+          parent = chpl_getPrivatizedCopy(tBarrier, pid);
+      if 2*me+1 < numParticipants then
+        on Locales[2*me+1] do
+          left = chpl_getPrivatizedCopy(tBarrier, pid);
+      if 2*me+2 < numParticipants then
+        on Locales[2*me+2] do
+          right = chpl_getPrivatizedCopy(tBarrier, pid);
+    }
+
+    pragma "no doc"
+    proc arrive() {
+      on this do arrived.add(1);
+    }
+
+    pragma "no doc"
+    proc release(e: int) {
+      on this do released.write(e);
+    }
+
+    pragma "no doc"
+    proc combine(e: int) {
+      arrived.waitFor(e * numChildren);
+      if parent != nil {
+        parent.arrive();
+        released.waitFor(e);
+      }
+      if left != nil then left.release(e);
+      if right != nil then right.release(e);
+    }
+  }
+
   pragma "no doc"
   proc =(ref lhs: Barrier, rhs: Barrier) {
     if lhs.owned {
+      if lhs.pid != nullPid then
+        _freePrivatizedClass(lhs.pid, lhs.bar);
       delete lhs.bar;
     }
     lhs.bar = rhs.bar;
+    lhs.pid = rhs.pid;
     lhs.owned = false;
   }
 
@@ -358,6 +627,7 @@ module Barrier {
     pragma "no auto destroy"
     var ret: Barrier;
     ret.bar = b.bar;
+    ret.pid = b.pid;
     ret.owned = false;
     return ret;
   }
@@ -20,6 +20,10 @@
 /*
   This module provides a simple singly linked list.
 
+  Each element is stored in its own node, so a list used as a growable
+  array is better served by the :mod:`Vectors` module, whose elements are
+  contiguous.
+
   .. note::
 
       This module is expected to change in the future.
@@ -85,6 +85,8 @@
 module Memory {
 
 pragma "insert line file info" private extern proc chpl_memoryUsed(): uint(64);
+pragma "insert line file info" private extern proc chpl_memoryAllocations(): uint(64);
+pragma "insert line file info" private extern proc chpl_memoryFrees(): uint(64);
 
 /*
   The amount of memory returned by :proc:`locale.physicalMemory` can
@@ -145,6 +147,35 @@ proc memoryUsed() {
   return chpl_memoryUsed();
 }
 
+/*
+  How many allocations has this program made on this locale?
+
+  This counts the allocation requests made on the calling top-level
+  locale by the program, through Chapel mechanisms, since execution
+  began.  It is useful for checking how many allocations a piece of
+  code does, by comparing the counts before and after it.  A
+  reallocation counts as both a free and an allocation.
+
+  :returns: Number of allocations made.
+  :rtype: `uint(64)`
+ */
+proc memoryAllocations() {
+  return chpl_memoryAllocations();
+}
+
+/*
+  How many allocations has this program freed on this locale?
+
+  This is the counterpart of :proc:`memoryAllocations` for deallocation
+  requests.
+
+  :returns: Number of allocations freed.
+  :rtype: `uint(64)`
+ */
+proc memoryFrees() {
+  return chpl_memoryFrees();
+}
+
 /*
   Print detailed information about allocated memory to ``memLog``.
   The report contains a section for each top-level locale, containing
@@ -0,0 +1,348 @@
+/*
+ * Copyright 2004-2017 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+  This module provides a growable sequence stored in contiguous memory.
+
+  A :record:`vector` keeps its elements in a local array that is larger
+  than needed, so appending to it only reallocates when that array is full,
+  and then doubles its size.  Unlike the :mod:`List` module's linked
+  :record:`~List.list`, it doesn't allocate per element, can be indexed in
+  constant time, and can be iterated over in parallel, either on its own or
+  zippered with arrays of the same length:
+
+  .. code-block:: chapel
+
+    use Vectors;
+
+    var v: vector(real);
+    for i in 1..n do
+      v.append(i);
+    forall (x, a) in zip(v, A) do
+      x += a;
+
+  Elements are indexed from 1 to :proc:`vector.size`.  Copying or assigning
+  a vector copies its elements.
+
+  .. note::
+
+      This module is expected to change in the future.
+ */
+module Vectors {
+
+  // The capacity of a vector when it first allocates
+  private param minCapacity = 8;
+
+  // The elements of a vector.  Every vector owns its own storage.
+  pragma "no doc"
+  class VectorStorage {
+    type eltType;
+    var dom: domain(1) = {1..0};
+    var data: [dom] eltType;
+
+    // The vector's iterators live here rather than on the record: a forall
+    // loop copies the record it iterates over, so iterators on the record
+    // would write to the copy's elements.
+    iter these(n: int) ref {
+      for i in 1..n do
+        yield data[i];
+    }
+
+    iter these(n: int, param tag: iterKind) where tag == iterKind.leader {
+      for followThis in (0..#n).these(tag) do
+        yield followThis;
+    }
+
+    iter these(n: int, param tag: iterKind, followThis) ref
+      where tag == iterKind.follower {
+      if followThis.size != 1 then
+        compilerError("vectors can only be zippered with one-dimensional iterands");
+
+      // followThis is 0-based, the elements are 1-based
+      for i in followThis(1) do
+        yield data[i+1];
+    }
+  }
+
+  /*
+    A contiguous, growable sequence of elements.
+   */
+  record vector {
+    /*
+      The type of the elements stored in the vector.
+     */
+    type eltType;
+
+    pragma "no doc"
+    var storage = new VectorStorage(eltType);
+
+    /*
+      The number of elements in the vector.
+     */
+    var length: int;
+
+    /*
+       Synonym for length.
+     */
+    inline proc size {
+      return length;
+    }
+
+    /*
+      The number of elements the vector can hold before it must grow.
+     */
+    inline proc capacity {
+      return storage.dom.size;
+    }
+
+    /*
+      Returns `true` if the vector has no elements.
+     */
+    inline proc isEmpty() {
+      return length == 0;
+    }
+
+    // Grow the storage, by doubling, so that it can hold n elements
+    pragma "no doc"
+    inline proc ref ensureCapacity(n: int) {
+      const cap = capacity;
+      if n > cap then
+        resize(max(n, 2*cap, minCapacity));
+    }
+
+    pragma "no doc"
+    proc ref resize(newCapacity: int) {
+      storage.dom = {1..newCapacity};
+    }
+
+    /*
+      Make sure the vector can hold at least `n` elements without
+      reallocating.
+     */
+    proc ref reserve(n: int) {
+      if n > capacity then
+        resize(n);
+    }
+
+    /*
+      Release any storage beyond what the current elements need.
+     */
+    proc ref shrink() {
+      if length < capacity then
+        resize(length);
+    }
+
+    /*
+      Remove every element.  The storage is kept for reuse; call
+      :proc:`vector.shrink` afterwards to release it.
+     */
+    proc ref clear() {
+      if length > 0 {
+        var empty: eltType;
+        storage.data[1..length] = empty;
+      }
+      length = 0;
+    }
+
+    /*
+      Returns a reference to element `i`.  Halts if `i` is not in
+      `1..size` when bounds checking is enabled.
+     */
+    inline proc this(i: integral) ref {
+      if boundsChecking && (i < 1 || i > length) then
+        halt("vector index ", i, " out of bounds 1..", length);
+      return storage.data[i];
+    }
+
+    /*
+      Append `e` to the vector.
+     */
+    proc ref append(e: eltType) {
+      ensureCapacity(length+1);
+      length += 1;
+      storage.data[length] = e;
+    }
+
+    /*
+      Append all of the supplied arguments to the vector.
+     */
+    proc ref append(e: eltType, es: eltType ...?k) {
+      ensureCapacity(length+1+k);
+      append(e);
+      for param i in 1..k do
+        append(es(i));
+    }
+
+    /*
+      Append the elements of the one-dimensional array `A`, in order.
+     */
+    proc ref append(A: [] eltType) where A.rank == 1 {
+      const n = A.size;
+      if n == 0 then return;
+      ensureCapacity(length+n);
+      storage.data[length+1..#n] = A;
+      length += n;
+    }
+
+    /*
+      Append the elements of vector `v`.
+     */
+    proc ref append(v: vector(eltType)) {
+      const n = v.length;
+      if n == 0 then return;
+      ensureCapacity(length+n);
+      storage.data[length+1..#n] = v.storage.data[1..n];
+      length += n;
+    }
+
+    /*
+       Synonym for append.
+     */
+    inline proc ref push_back(e: eltType) {
+      append(e);
+    }
+
+    /*
+       Remove the last element from the vector and return it.
+       It is an error to call this function on an empty vector.
+     */
+    proc ref pop_back(): eltType {
+      if length < 1 then halt("pop_back on empty vector");
+      var empty: eltType;
+      var ret = storage.data[length];
+      storage.data[length] = empty;
+      length -= 1;
+      return ret;
+    }
+
+    /*
+      Returns a reference to the last element.  It is an error to call
+      this function on an empty vector.
+     */
+    proc back() ref {
+      if length < 1 then halt("back on empty vector");
+      return storage.data[length];
+    }
+
+    /*
+      Returns an array containing a copy of the elements.
+     */
+    proc toArray(): [1..length] eltType {
+      var A: [1..length] eltType;
+      if length > 0 then
+        A = storage.data[1..length];
+      return A;
+    }
+
+    /*
+      Iterate over the vector, yielding a reference to each element.
+
+      :ytype: eltType
+     */
+    proc these() {
+      return storage.these(length);
+    }
+
+    pragma "no doc"
+    proc deinit() {
+      delete storage;
+    }
+
+    pragma "no doc"
+    proc writeThis(f) {
+      var binary = f.binary();
+      var arrayStyle = f.styleElement(QIO_STYLE_ELEMENT_ARRAY);
+      var isspace = arrayStyle == QIO_ARRAY_FORMAT_SPACE && !binary;
+      var isjson = arrayStyle == QIO_ARRAY_FORMAT_JSON && !binary;
+      var ischpl = arrayStyle == QIO_ARRAY_FORMAT_CHPL && !binary;
+
+      if binary {
+        // Write the number of elements.
+        f <~> length;
+      }
+      if isjson || ischpl {
+        f <~> new ioLiteral("[");
+      }
+
+      for i in 1..length {
+        if i > 1 {
+          if isspace then f <~> new ioLiteral(" ");
+          else if isjson || ischpl then f <~> new ioLiteral(", ");
+        }
+
+        f <~> storage.data[i];
+      }
+
+      if isjson || ischpl {
+        f <~> new ioLiteral("]");
+      }
+    }
+  }
+
+  pragma "no doc"
+  pragma "init copy fn"
+  proc chpl__initCopy(x: vector(?t)) {
+    var ret: vector(t);
+    ret.append(x);
+    return ret;
+  }
+
+  pragma "no doc"
+  pragma "auto copy fn"
+  proc chpl__autoCopy(x: vector(?t)) {
+    var ret: vector(t);
+    ret.append(x);
+    return ret;
+  }
+
+  pragma "no doc"
+  proc =(ref lhs: vector(?t), rhs: vector(t)) {
+    if lhs.storage == rhs.storage then return;
+    lhs.clear();
+    lhs.append(rhs);
+  }
+
+  /*
+    Construct a new :record:`vector` containing all of the supplied
+    arguments.
+
+    :arg x: Every argument must be of type `T`.
+    :type x: `T`
+    :rtype: vector(T)
+   */
+  proc makeVector(x ...?k) {
+    var v: vector(x(1).type);
+    v.reserve(k);
+    for param i in 1..k do
+      v.append(x(i));
+    return v;
+  }
+
+  /*
+    Construct a new :record:`vector` containing the elements of the
+    one-dimensional array `A`.
+
+    :rtype: vector(A.eltType)
+   */
+  proc makeVector(A: [] ?t) where A.rank == 1 {
+    var v: vector(t);
+    v.append(A);
+    return v;
+  }
+}
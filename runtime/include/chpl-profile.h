@@ -0,0 +1,53 @@
+/*
+ * Copyright 2004-2017 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ * 
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * 
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//
+// Execution counts for profile-guided optimization.
+//
+// A program compiled with --profile-gen bumps one counter per instrumented
+// site, either the entry to a function or the top of a loop body.  The
+// compiler numbers the sites and describes them in the chpl_prof_site*
+// tables (see chplcgfns.h).  At exit each locale writes its nonzero counts
+// to the file named by CHPL_RT_PROFILE_FILE, from which a later compile
+// with --profile-use reads them back.
+//
+
+#ifndef _chpl_profile_h_
+#define _chpl_profile_h_
+#ifndef LAUNCHER
+#include <stdint.h>
+#include "chpl-atomics.h"
+
+#define CHPL_PROF_SITE_FN   0
+#define CHPL_PROF_SITE_LOOP 1
+
+void chpl_prof_init(void);
+
+void chpl_prof_exit(void);
+
+// Implementation is here for performance: the instrumented program calls
+// this once per function call and loop iteration.
+extern atomic_uint_least64_t* chpl_prof_counts;
+static inline void chpl_prof_count(int32_t site) {
+  atomic_fetch_add_explicit_uint_least64_t(&chpl_prof_counts[site], 1,
+                                           memory_order_relaxed);
+}
+
+#endif // LAUNCHER
+#endif // _chpl_profile_h_
@@ -71,6 +71,18 @@ int32_t string_compare(c_string x, c_string y) {
   return (int32_t)strcmp(x, y);
 }
 
+//
+// One NUL-terminated string for each byte value.  Chapel strings of length
+// one refer to these rather than allocating (see String.chpl), so they must
+// never be written to.
+//
+extern const unsigned char chpl_string_byte_table[512];
+
+static inline
+uint8_t* chpl_string_single_byte(uint8_t b) {
+  return (uint8_t*) &chpl_string_byte_table[2*b];
+}
+
 //
 // stopgap formatting
 //
@@ -84,6 +96,17 @@ chpl_bool string_contains(c_string x, c_string y);
 c_string_copy string_copy(c_string x, int32_t lineno, int32_t filename);
 c_string_copy string_concat(c_string x, c_string y, int32_t lineno, int32_t filename);
 int string_index_of(c_string x, c_string y);
+
+// Search a buffer of haystackLen bytes for the needleLen bytes of needle.
+// Neither needs to be NUL-terminated.  find and rfind return the 0-based
+// offset of the first or last match, or -1 if there is none; count
+// includes overlapping matches.
+int64_t chpl_string_find(const uint8_t* haystack, int64_t haystackLen,
+                         const uint8_t* needle, int64_t needleLen);
+int64_t chpl_string_rfind(const uint8_t* haystack, int64_t haystackLen,
+                          const uint8_t* needle, int64_t needleLen);
+int64_t chpl_string_count(const uint8_t* haystack, int64_t haystackLen,
+                          const uint8_t* needle, int64_t needleLen);
 c_string_copy string_index(c_string x, int i, int32_t lineno, int32_t filename);
 // TODO: A separate unstrided version could return a c_string instead.
 c_string_copy string_select(c_string x, int low, int high, int stride, int32_t lineno, int32_t filename);
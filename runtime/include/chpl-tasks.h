@@ -330,6 +330,16 @@ uint32_t chpl_task_getNumRunningTasks(void);
 //
 int32_t chpl_task_getNumBlockedTasks(void);
 
+//
+// returns the number of waits on sync or single variables that were
+// satisfied while the waiting task was still spinning, and the number
+// of times a waiting thread had to park (suspend).  Waits that find the
+// variable in the desired state right away are not counted.  Tasking
+// layers that do not track these return 0.
+//
+uint64_t chpl_task_getNumSyncSpinWaits(void);
+uint64_t chpl_task_getNumSyncParks(void);
+
 
 // Threads
 
@@ -80,6 +80,14 @@ extern const c_string chpl_funSymTable[];
 extern const int chpl_filenumSymTable[];
 extern const int32_t chpl_sizeSymTable;
 
+// Sites instrumented by --profile-gen.  chpl_prof_siteInfo holds a
+// (kind, filename index, line number) triple per site and
+// chpl_prof_siteNames the name of the enclosing function.
+// Defined in chpl_compilation_config.c
+extern const int32_t chpl_prof_numSites;
+extern const c_string chpl_prof_siteNames[];
+extern const int chpl_prof_siteInfo[];
+
 extern char* chpl_executionCommand;
 
 /* generated */
@@ -44,6 +44,8 @@ void chpl_setMemFlags(void);
 void chpl_reportMemInfo(void);
 
 uint64_t chpl_memoryUsed(int32_t lineno, int32_t filename);
+uint64_t chpl_memoryAllocations(int32_t lineno, int32_t filename);
+uint64_t chpl_memoryFrees(int32_t lineno, int32_t filename);
 void chpl_printMemAllocStats(int32_t lineno, int32_t filename);
 void chpl_printMemAllocsByType(int32_t lineno, int32_t filename);
 void chpl_printMemAllocs(int64_t threshold,
@@ -55,6 +55,7 @@
 #include "chplmemtrack.h"
 #include "chpl-prefetch.h"
 #include "chpl-privatization.h"
+#include "chpl-profile.h"
 #include "chpl-string.h"
 #include "chplsys.h"
 #include "chpl-tasks.h"
@@ -79,11 +79,27 @@ typedef pthread_cond_t chpl_thread_condvar_t;
 //
 // Sync variables
 //
+// A task waiting on a sync variable first spins for a bounded time,
+// then parks its thread.  On Linux threads park on a futex word per
+// direction, which is bumped whenever the variable is marked full or
+// empty; elsewhere they park on condition variables.
+//
+#ifdef __linux__
+#define CHPL_SYNC_USE_FUTEX 1
+#endif
+
 typedef struct {
   volatile chpl_bool  is_full;
   chpl_thread_mutex_t lock;
+#ifdef CHPL_SYNC_USE_FUTEX
+  volatile int32_t    full_seq;       // futex word: bumped when marked full
+  volatile int32_t    empty_seq;      // futex word: bumped when marked empty
+#else
   chpl_thread_condvar_t signal_full;  // wait for full; signal this when full
   chpl_thread_condvar_t signal_empty; // wait for empty; signal this when empty
+#endif
+  int32_t             parked_full;    // threads parked waiting for full
+  int32_t             parked_empty;   // threads parked waiting for empty
   //  threadlayer_sync_aux_t tl_aux;
 } chpl_sync_aux_t;
 
@@ -30,6 +30,7 @@
 #include "chpl-mem.h"
 #include "chplmemtrack.h"
 #include "chpl-privatization.h"
+#include "chpl-profile.h"
 #include "chpl-tasks.h"
 #include "chpl-topo.h"
 #include "chpl-linefile-support.h"
@@ -186,6 +187,9 @@ void chpl_rt_init(int argc, char* argv[]) {
   // Initialize privatization, needs to happen before hitting module init
   chpl_privatization_init();
 
+  // Allocate the --profile-gen counters before any Chapel code runs
+  chpl_prof_init();
+
   //
   // Some comm layer initialization has to wait until after the
   // tasking layer is initialized.
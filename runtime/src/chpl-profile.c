@@ -0,0 +1,105 @@
+/*
+ * Copyright 2004-2017 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ * 
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * 
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "chplrt.h"
+#include "chpl-profile.h"
+#include "chplcgfns.h"
+#include "chpl-comm.h"
+#include "chpl-env.h"
+#include "chpl-linefile-support.h"
+#include "chpl-mem-sys.h"
+#include "error.h"
+
+#include <stdio.h>
+
+#define CHPL_PROF_DEFAULT_FILE "chpl-profile.dat"
+
+atomic_uint_least64_t* chpl_prof_counts = NULL;
+
+//
+// The counters are allocated directly from the system allocator so that
+// instrumenting a program does not change what the memory tracking and
+// leak reporting see.
+//
+void chpl_prof_init(void) {
+  int32_t i;
+
+  if (chpl_prof_numSites == 0)
+    return;
+
+  chpl_prof_counts = sys_calloc(chpl_prof_numSites,
+                                sizeof(atomic_uint_least64_t));
+  if (chpl_prof_counts == NULL)
+    chpl_internal_error("cannot allocate profile counters");
+
+  for (i = 0; i < chpl_prof_numSites; i++)
+    atomic_init_uint_least64_t(&chpl_prof_counts[i], 0);
+}
+
+//
+// Locale 0 writes the named file; other locales append their locale
+// number to the name so that concurrent writers never share a file.
+//
+void chpl_prof_exit(void) {
+  const char* base;
+  char        name[FILENAME_MAX];
+  FILE*       fp;
+  int32_t     i;
+
+  if (chpl_prof_counts == NULL)
+    return;
+
+  base = chpl_get_rt_env("PROFILE_FILE", CHPL_PROF_DEFAULT_FILE);
+
+  if (chpl_nodeID == 0)
+    snprintf(name, sizeof(name), "%s", base);
+  else
+    snprintf(name, sizeof(name), "%s.%d", base, (int) chpl_nodeID);
+
+  if ((fp = fopen(name, "w")) == NULL) {
+    char msg[FILENAME_MAX + 64];
+
+    snprintf(msg, sizeof(msg), "cannot open profile file '%s'", name);
+    chpl_warning(msg, 0, 0);
+    return;
+  }
+
+  fprintf(fp, "# Chapel execution profile: kind, count, file, line, name\n");
+
+  for (i = 0; i < chpl_prof_numSites; i++) {
+    uint_least64_t count;
+    int            kind;
+
+    count = atomic_load_explicit_uint_least64_t(&chpl_prof_counts[i],
+                                                memory_order_relaxed);
+    if (count == 0)
+      continue;
+
+    kind = chpl_prof_siteInfo[3 * i];
+
+    fprintf(fp, "%s\t%llu\t%s\t%d\t%s\n",
+            (kind == CHPL_PROF_SITE_LOOP) ? "loop" : "fn",
+            (unsigned long long) count,
+            chpl_lookupFilename(chpl_prof_siteInfo[3 * i + 1]),
+            chpl_prof_siteInfo[3 * i + 2],
+            chpl_prof_siteNames[i]);
+  }
+
+  fclose(fp);
+}
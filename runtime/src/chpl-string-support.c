@@ -31,6 +31,9 @@
  * considering naming things more consistently.
  *
  */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // for memrchr
+#endif
 #include <stdarg.h>
 #include "chplrt.h"
 #include "sys_basic.h"
@@ -39,6 +42,24 @@
 #include "chpltypes.h"
 #include "error.h"
 
+#define CHPL_STRING_BYTE1(b) (unsigned char)(b), 0
+#define CHPL_STRING_BYTE4(b) CHPL_STRING_BYTE1(b), CHPL_STRING_BYTE1(b+1), \
+                             CHPL_STRING_BYTE1(b+2), CHPL_STRING_BYTE1(b+3)
+#define CHPL_STRING_BYTE16(b) CHPL_STRING_BYTE4(b), CHPL_STRING_BYTE4(b+4), \
+                              CHPL_STRING_BYTE4(b+8), CHPL_STRING_BYTE4(b+12)
+#define CHPL_STRING_BYTE64(b) CHPL_STRING_BYTE16(b), CHPL_STRING_BYTE16(b+16), \
+                              CHPL_STRING_BYTE16(b+32), CHPL_STRING_BYTE16(b+48)
+
+const unsigned char chpl_string_byte_table[512] = {
+  CHPL_STRING_BYTE64(0), CHPL_STRING_BYTE64(64),
+  CHPL_STRING_BYTE64(128), CHPL_STRING_BYTE64(192)
+};
+
+#undef CHPL_STRING_BYTE64
+#undef CHPL_STRING_BYTE16
+#undef CHPL_STRING_BYTE4
+#undef CHPL_STRING_BYTE1
+
 // Uses the system allocator.  Should not be used to create user-visible data
 // (error messages are OK).
 char* chpl_glom_strings(int numstrings, ...) {
@@ -128,6 +149,325 @@ int string_index_of(c_string haystack, c_string needle) {
   return substring ? (int) (substring-haystack)+1 : 0;
 }
 
+//
+// Byte-string search
+//
+// These work on buffers with explicit lengths, which need not be NUL
+// terminated, and return the 0-based offset of a match or -1.  Single
+// bytes and short needles are found with memchr, which the C library
+// implements with vector instructions, and the rest of a candidate match
+// is checked with memcmp.  Longer needles use the Two-Way algorithm
+// (Crochemore and Perrin, 1991), which runs in linear time and constant
+// space, together with a bad-character shift on the needle's last byte.
+// Searches from the right mirror these, with memrchr where the C library
+// has it and Two-Way run over the reversed needle and haystack.
+//
+
+// Needles up to this long are matched by memchr on their first byte.
+#define CHPL_STRING_SHORT_NEEDLE 8
+
+static int64_t find_short(const uint8_t* h, int64_t hLen,
+                          const uint8_t* n, int64_t nLen) {
+  const uint8_t* p = h;
+  const uint8_t* last = h + hLen - nLen; // last possible start of a match
+
+  while (p <= last) {
+    p = (const uint8_t*) memchr(p, n[0], last - p + 1);
+    if (p == NULL)
+      return -1;
+    if (memcmp(p + 1, n + 1, nLen - 1) == 0)
+      return p - h;
+    p++;
+  }
+  return -1;
+}
+
+static int64_t find_two_way(const uint8_t* h, int64_t hLen,
+                            const uint8_t* n, int64_t nLen) {
+  const size_t l = (size_t) nLen;
+  const uint8_t* hp = h;
+  const uint8_t* z = h + hLen;
+  size_t i, ip, jp, k, p, ms, p0, mem, mem0;
+  size_t shift[256];
+
+  // shift[b] is how far the window may move when the byte under the
+  // needle's last position is b
+  for (i = 0; i < 256; i++)
+    shift[i] = l;
+  for (i = 0; i < l - 1; i++)
+    shift[n[i]] = l - 1 - i;
+
+  // Critical factorization: the maximal suffix of the needle under each
+  // ordering of the alphabet, keeping the longer of the two.
+  ip = -1; jp = 0; k = p = 1;
+  while (jp + k < l) {
+    if (n[ip+k] == n[jp+k]) {
+      if (k == p) {
+        jp += p;
+        k = 1;
+      } else k++;
+    } else if (n[ip+k] > n[jp+k]) {
+      jp += k;
+      k = 1;
+      p = jp - ip;
+    } else {
+      ip = jp++;
+      k = p = 1;
+    }
+  }
+  ms = ip;
+  p0 = p;
+
+  ip = -1; jp = 0; k = p = 1;
+  while (jp + k < l) {
+    if (n[ip+k] == n[jp+k]) {
+      if (k == p) {
+        jp += p;
+        k = 1;
+      } else k++;
+    } else if (n[ip+k] < n[jp+k]) {
+      jp += k;
+      k = 1;
+      p = jp - ip;
+    } else {
+      ip = jp++;
+      k = p = 1;
+    }
+  }
+  if (ip + 1 > ms + 1) ms = ip;
+  else p = p0;
+
+  // If the needle is periodic, remember how much of it is known to match
+  // after shifting by the period; otherwise shift by more than either half.
+  if (memcmp(n, n + p, ms + 1) != 0) {
+    mem0 = 0;
+    p = (ms > l - ms - 1 ? ms : l - ms - 1) + 1;
+  } else {
+    mem0 = l - p;
+  }
+  mem = 0;
+
+  while ((size_t)(z - hp) >= l) {
+    // Check the last byte first and skip ahead when it can't match.  A
+    // periodic needle with a byte out of place in its last period can't
+    // match until past that byte.
+    if (hp[l-1] != n[l-1]) {
+      k = shift[hp[l-1]];
+      if (mem && k < p) k = l - p;
+      hp += k;
+      mem = 0;
+      continue;
+    }
+
+    // Compare the right half, then the left half.
+    for (k = (ms + 1 > mem ? ms + 1 : mem); k < l && n[k] == hp[k]; k++);
+    if (k < l) {
+      hp += k - ms;
+      mem = 0;
+      continue;
+    }
+    for (k = ms + 1; k > mem && n[k-1] == hp[k-1]; k--);
+    if (k <= mem)
+      return hp - h;
+    hp += p;
+    mem = mem0;
+  }
+  return -1;
+}
+
+// Returns the last occurrence of byte c in the n bytes at s, or NULL.
+static const uint8_t* rfind_byte(const uint8_t* s, uint8_t c, int64_t n) {
+#ifdef __GLIBC__
+  return (const uint8_t*) memrchr(s, c, n);
+#else
+  const uint8_t* p = s + n;
+
+  while (p > s) {
+    if (*--p == c)
+      return p;
+  }
+  return NULL;
+#endif
+}
+
+static int64_t rfind_short(const uint8_t* h, int64_t hLen,
+                           const uint8_t* n, int64_t nLen) {
+  const uint8_t* p;
+  int64_t starts = hLen - nLen + 1; // number of possible starts left
+
+  while (starts > 0) {
+    p = rfind_byte(h, n[0], starts);
+    if (p == NULL)
+      return -1;
+    if (memcmp(p + 1, n + 1, nLen - 1) == 0)
+      return p - h;
+    starts = p - h;
+  }
+  return -1;
+}
+
+// find_two_way() with the needle and haystack read back to front: RN(i)
+// is byte i of the reversed needle, and RH(i) byte i of the reversed
+// window, which ends just before 'z'.  Returns the offset of the last
+// match from h.
+#define RN(i) n[l - 1 - (i)]
+#define RH(i) z[-1 - (int64_t)(i)]
+
+static int64_t rfind_two_way(const uint8_t* h, int64_t hLen,
+                             const uint8_t* n, int64_t nLen) {
+  const size_t l = (size_t) nLen;
+  const uint8_t* z = h + hLen;
+  size_t i, ip, jp, k, p, ms, p0, mem, mem0;
+  size_t shift[256];
+
+  for (i = 0; i < 256; i++)
+    shift[i] = l;
+  for (i = 0; i < l - 1; i++)
+    shift[RN(i)] = l - 1 - i;
+
+  ip = -1; jp = 0; k = p = 1;
+  while (jp + k < l) {
+    if (RN(ip+k) == RN(jp+k)) {
+      if (k == p) {
+        jp += p;
+        k = 1;
+      } else k++;
+    } else if (RN(ip+k) > RN(jp+k)) {
+      jp += k;
+      k = 1;
+      p = jp - ip;
+    } else {
+      ip = jp++;
+      k = p = 1;
+    }
+  }
+  ms = ip;
+  p0 = p;
+
+  ip = -1; jp = 0; k = p = 1;
+  while (jp + k < l) {
+    if (RN(ip+k) == RN(jp+k)) {
+      if (k == p) {
+        jp += p;
+        k = 1;
+      } else k++;
+    } else if (RN(ip+k) < RN(jp+k)) {
+      jp += k;
+      k = 1;
+      p = jp - ip;
+    } else {
+      ip = jp++;
+      k = p = 1;
+    }
+  }
+  if (ip + 1 > ms + 1) ms = ip;
+  else p = p0;
+
+  // RN(i) == RN(i+p) for i <= ms, i.e. n[j] == n[j-p] for j >= l-1-ms,
+  // decides whether the reversed needle is periodic.
+  if (memcmp(n + l - 1 - ms, n + l - 1 - ms - p, ms + 1) != 0) {
+    mem0 = 0;
+    p = (ms > l - ms - 1 ? ms : l - ms - 1) + 1;
+  } else {
+    mem0 = l - p;
+  }
+  mem = 0;
+
+  while ((size_t)(z - h) >= l) {
+    if (RH(l-1) != RN(l-1)) {
+      k = shift[RH(l-1)];
+      if (mem && k < p) k = l - p;
+      z -= k;
+      mem = 0;
+      continue;
+    }
+
+    for (k = (ms + 1 > mem ? ms + 1 : mem); k < l && RN(k) == RH(k); k++);
+    if (k < l) {
+      z -= k - ms;
+      mem = 0;
+      continue;
+    }
+    for (k = ms + 1; k > mem && RN(k-1) == RH(k-1); k--);
+    if (k <= mem)
+      return (z - h) - l;
+    z -= p;
+    mem = mem0;
+  }
+  return -1;
+}
+
+#undef RH
+#undef RN
+
+int64_t chpl_string_find(const uint8_t* haystack, int64_t haystackLen,
+                         const uint8_t* needle, int64_t needleLen) {
+  const uint8_t* p;
+  int64_t offset;
+
+  if (needleLen == 0)
+    return 0;
+  if (needleLen > haystackLen)
+    return -1;
+  if (needleLen == 1) {
+    p = (const uint8_t*) memchr(haystack, needle[0], haystackLen);
+    return p ? p - haystack : -1;
+  }
+  if (needleLen <= CHPL_STRING_SHORT_NEEDLE)
+    return find_short(haystack, haystackLen, needle, needleLen);
+
+  // Skip to the first possible start before setting up Two-Way.
+  p = (const uint8_t*) memchr(haystack, needle[0],
+                              haystackLen - needleLen + 1);
+  if (p == NULL)
+    return -1;
+  offset = find_two_way(p, haystackLen - (p - haystack), needle, needleLen);
+  return offset < 0 ? -1 : offset + (p - haystack);
+}
+
+int64_t chpl_string_rfind(const uint8_t* haystack, int64_t haystackLen,
+                          const uint8_t* needle, int64_t needleLen) {
+  const uint8_t* p;
+  int64_t end;
+
+  if (needleLen == 0)
+    return haystackLen;
+  if (needleLen > haystackLen)
+    return -1;
+  if (needleLen == 1) {
+    p = rfind_byte(haystack, needle[0], haystackLen);
+    return p ? p - haystack : -1;
+  }
+  if (needleLen <= CHPL_STRING_SHORT_NEEDLE)
+    return rfind_short(haystack, haystackLen, needle, needleLen);
+
+  // Skip back to the last possible end before setting up Two-Way.
+  p = rfind_byte(haystack + needleLen - 1, needle[needleLen-1],
+                 haystackLen - needleLen + 1);
+  if (p == NULL)
+    return -1;
+  end = p - haystack + 1;
+  return rfind_two_way(haystack, end, needle, needleLen);
+}
+
+int64_t chpl_string_count(const uint8_t* haystack, int64_t haystackLen,
+                          const uint8_t* needle, int64_t needleLen) {
+  int64_t count = 0;
+  int64_t start = 0;
+  int64_t offset;
+
+  if (needleLen == 0)
+    return haystackLen + 1;
+
+  // Matches may overlap, so resume the search one byte past each match.
+  while ((offset = chpl_string_find(haystack + start, haystackLen - start,
+                                    needle, needleLen)) >= 0) {
+    count++;
+    start += offset + 1;
+  }
+  return count;
+}
+
 // Returns a newly-allocated string containing (a copy of) the bytes selected
 // from the original string.
 // It is up to the caller to make sure low and high are within the string
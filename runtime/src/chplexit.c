@@ -23,6 +23,7 @@
 #include "chpl-comm.h"
 #include "chplexit.h"
 #include "chpl-mem.h"
+#include "chpl-profile.h"
 #include "chplmemtrack.h"
 #include "chpl-topo.h"
 #include "gdb.h"
@@ -41,6 +42,7 @@ static void chpl_exit_common(int status, int all) {
   chpl_comm_pre_task_exit(all);
   if (all) {
     chpl_task_exit();
+    chpl_prof_exit();
     chpl_reportMemInfo();
   }
   chpl_mem_exit();
@@ -96,6 +96,8 @@ static size_t totalMem = 0;       /* total memory currently allocated */
 static size_t maxMem = 0;         /* maximum total memory during run  */
 static size_t totalAllocated = 0; /* total memory allocated */
 static size_t totalFreed = 0;     /* total memory freed */
+static size_t totalAllocs = 0;    /* number of allocations made */
+static size_t totalFrees = 0;     /* number of allocations freed */
 static size_t totalEntries = 0;     /* number of entries in hash table */
 
 static chpl_sync_aux_t memTrack_sync;
@@ -176,6 +178,7 @@ static unsigned hash(void* memAlloc, int hashSize) {
 static void increaseMemStat(size_t chunk, int32_t lineno, int32_t filename) {
   totalMem += chunk;
   totalAllocated += chunk;
+  totalAllocs += 1;
   if (memMax && (totalMem > memMax)) {
     chpl_error("Exceeded memory limit", lineno, filename);
   }
@@ -187,6 +190,7 @@ static void increaseMemStat(size_t chunk, int32_t lineno, int32_t filename) {
 static void decreaseMemStat(size_t chunk) {
   totalMem -= chunk; // > totalMem ? 0 : totalMem - chunk;
   totalFreed += chunk;
+  totalFrees += 1;
 }
 
 
@@ -291,6 +295,28 @@ uint64_t chpl_memoryUsed(int32_t lineno, int32_t filename) {
 }
 
 
+uint64_t chpl_memoryAllocations(int32_t lineno, int32_t filename) {
+  if (!chpl_memTrack) {
+    chpl_warning("invalid call to memoryAllocations(); rerun with --memTrack",
+                 lineno, filename);
+    return 0;
+  }
+
+  return (uint64_t)totalAllocs;
+}
+
+
+uint64_t chpl_memoryFrees(int32_t lineno, int32_t filename) {
+  if (!chpl_memTrack) {
+    chpl_warning("invalid call to memoryFrees(); rerun with --memTrack",
+                 lineno, filename);
+    return 0;
+  }
+
+  return (uint64_t)totalFrees;
+}
+
+
 void chpl_printMemAllocStats(int32_t lineno, int32_t filename) {
   if (!chpl_memTrack) {
     chpl_warning("invalid call to printMemAllocStats(); rerun with --memTrack",
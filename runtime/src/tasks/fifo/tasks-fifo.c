@@ -30,6 +30,7 @@
 #include "chpl-mem.h"
 #include "chpl-tasks.h"
 #include "chpl-tasks-callbacks-internal.h"
+#include "chpl-atomics.h"
 #include "chplsys.h"
 #include "chpl-linefile-support.h"
 #include "error.h"
@@ -43,6 +44,10 @@
 #include <sys/mman.h>
 #include <unistd.h>
 #include <math.h>
+#ifdef CHPL_SYNC_USE_FUTEX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
 
 
 //
@@ -116,6 +121,19 @@ static chpl_thread_mutex_t taskTable_lock;     // critical section lock
 
 static chpl_fn_p comm_task_fn;
 
+//
+// A task waiting on a sync variable polls it up to sync_spin_polls
+// times, backing off exponentially (up to SYNC_MAX_BACKOFF pause
+// instructions) between polls, before parking its thread.  The number
+// of polls can be set with CHPL_RT_SYNC_SPIN; 0 parks right away.
+//
+#define SYNC_DEFAULT_SPIN_POLLS 16
+#define SYNC_MAX_BACKOFF        1024
+
+static int32_t               sync_spin_polls = SYNC_DEFAULT_SPIN_POLLS;
+static atomic_uint_least64_t sync_spin_waits; // waits satisfied by spinning
+static atomic_uint_least64_t sync_parks;      // times a thread parked
+
 //
 // Internal functions.
 //
@@ -149,70 +167,94 @@ static task_pool_p             add_to_task_pool(chpl_fn_int_t, chpl_fn_p,
 //
 // Condition variable methods
 //
+#ifndef CHPL_SYNC_USE_FUTEX
 static void chpl_thread_condvar_init(chpl_thread_condvar_t* cv);
+#endif
 
 //
 // Sync variable methods
 //
-static chpl_bool chpl_thread_sync_suspend(chpl_sync_aux_t *s,
-                                   struct timeval *deadline);
-static void chpl_thread_sync_awaken(chpl_sync_aux_t *s);
+static chpl_bool sync_park(chpl_sync_aux_t *s, chpl_bool want_full,
+                           struct timeval *deadline);
+static void sync_wake(chpl_sync_aux_t *s);
 
 // Sync variables
 
+static inline void sync_cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+  __asm__ __volatile__("pause" ::: "memory");
+#else
+  __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+//
+// Poll the sync variable, without holding its lock, until it reaches
+// the desired state or the spin budget runs out.  If we're
+// oversubscribing the hardware we yield between polls instead of
+// backing off, so as not to keep the task that will fill or empty the
+// variable off the processor.
+//
+static chpl_bool sync_spin(chpl_sync_aux_t *s, chpl_bool want_full,
+                           chpl_bool oversubscribed) {
+  int32_t i;
+  int     j, backoff = 1;
+
+  for (i = 0; i < sync_spin_polls; i++) {
+    if (s->is_full == want_full)
+      return true;
+
+    if (oversubscribed)
+      chpl_thread_yield();
+    else {
+      for (j = 0; j < backoff; j++)
+        sync_cpu_relax();
+      if (backoff < SYNC_MAX_BACKOFF)
+        backoff *= 2;
+    }
+  }
+
+  return s->is_full == want_full;
+}
+
 static void sync_wait_and_lock(chpl_sync_aux_t *s,
                                chpl_bool want_full,
                                int32_t lineno, int32_t filename) {
-  chpl_bool suspend_using_cond;
-
   chpl_thread_mutexLock(&s->lock);
 
-  // If we're oversubscribing the hardware, we wait using conditionals
-  // in order to ensure fairness and thus progress.  If we're not, we
-  // can spin-wait.
-  suspend_using_cond = (chpl_thread_getNumThreads() >=
-                        chpl_getNumLogicalCpus(true));
+  if (s->is_full != want_full && sync_spin_polls > 0) {
+    chpl_bool oversubscribed = (chpl_thread_getNumThreads() >=
+                                chpl_getNumLogicalCpus(true));
+
+    // Handoffs between tasks are often short, so spin for a while
+    // before paying for a sleep and a wakeup.
+    chpl_thread_mutexUnlock(&s->lock);
+    (void) sync_spin(s, want_full, oversubscribed);
+    chpl_thread_mutexLock(&s->lock);
+    if (s->is_full == want_full)
+      atomic_fetch_add_explicit_uint_least64_t(&sync_spin_waits, 1,
+                                               memory_order_relaxed);
+  }
 
   while (s->is_full != want_full) {
-    if (!suspend_using_cond) {
-      chpl_thread_mutexUnlock(&s->lock);
-    }
     if (set_block_loc(lineno, filename)) {
       // all other tasks appear to be blocked
-      struct timeval deadline, now;
+      struct timeval deadline;
       chpl_bool timed_out = false;
-      // default value so that always allows condition to be true if not
-      // using conditionals
 
       gettimeofday(&deadline, NULL);
       deadline.tv_sec += 1;
-      do {
-        if (suspend_using_cond)
-          timed_out = chpl_thread_sync_suspend(s, &deadline);
-        else
-          chpl_thread_yield();
-        
-        if (s->is_full != want_full && !timed_out)
-          gettimeofday(&now, NULL);
-      } while (s->is_full != want_full
-               && !timed_out
-               && (now.tv_sec < deadline.tv_sec
-                   || (now.tv_sec == deadline.tv_sec
-                       && now.tv_usec < deadline.tv_usec)));
+      while (s->is_full != want_full && !timed_out)
+        timed_out = sync_park(s, want_full, &deadline);
       if (s->is_full != want_full)
         check_for_deadlock();
     }
     else {
       do {
-        if (suspend_using_cond)
-          (void) chpl_thread_sync_suspend(s, NULL);
-        else
-          chpl_thread_yield();
+        (void) sync_park(s, want_full, NULL);
       } while (s->is_full != want_full);
     }
     unset_block_loc();
-    if (!suspend_using_cond)
-      chpl_thread_mutexLock(&s->lock);
   }
 
   if (blockreport)
@@ -237,39 +279,103 @@ void chpl_sync_waitEmptyAndLock(chpl_sync_aux_t *s,
   sync_wait_and_lock(s, false, lineno, filename);
 }
 
-static chpl_bool chpl_thread_sync_suspend(chpl_sync_aux_t *s,
-                                   struct timeval *deadline) {
-  chpl_thread_condvar_t* cond;
-  cond = s->is_full ? &s->signal_empty : &s->signal_full;
+//
+// Park the calling thread until the sync variable may have reached
+// the desired state, or until the deadline (if any) passes.  This is
+// called, and returns, with the variable's lock held.  Returns true if
+// the deadline passed.
+//
+static chpl_bool sync_park(chpl_sync_aux_t *s, chpl_bool want_full,
+                           struct timeval *deadline) {
+  int32_t*  parked = want_full ? &s->parked_full : &s->parked_empty;
+  chpl_bool timed_out = false;
+
+  atomic_fetch_add_explicit_uint_least64_t(&sync_parks, 1,
+                                           memory_order_relaxed);
+
+#ifdef CHPL_SYNC_USE_FUTEX
+  {
+    volatile int32_t* seq = want_full ? &s->full_seq : &s->empty_seq;
+    int32_t           seq_val = *seq;
+    struct timespec   ts;
+    struct timespec*  tsp = NULL;
+
+    if (deadline != NULL) {
+      struct timeval now;
+      int64_t        usec;
+
+      gettimeofday(&now, NULL);
+      usec = (int64_t) (deadline->tv_sec - now.tv_sec) * 1000000
+             + (deadline->tv_usec - now.tv_usec);
+      if (usec <= 0)
+        return true;
+      ts.tv_sec  = usec / 1000000;
+      ts.tv_nsec = (usec % 1000000) * 1000;
+      tsp = &ts;
+    }
 
-  if (deadline == NULL) {
-    (void) pthread_cond_wait(cond, (pthread_mutex_t*) &s->lock);
-    return false;
+    // The sequence number was read under the lock, so if the variable
+    // changes state after we drop it the futex wait returns at once.
+    (*parked)++;
+    chpl_thread_mutexUnlock(&s->lock);
+    if (syscall(SYS_futex, seq, FUTEX_WAIT_PRIVATE, seq_val, tsp, NULL, 0)
+        == -1 && errno == ETIMEDOUT)
+      timed_out = true;
+    chpl_thread_mutexLock(&s->lock);
+    (*parked)--;
   }
-  else {
-    struct timespec ts;
-    ts.tv_sec  = deadline->tv_sec;
-    ts.tv_nsec = deadline->tv_usec * 1000UL;
-    return (pthread_cond_timedwait(cond, (pthread_mutex_t*) &s->lock, &ts)
-            == ETIMEDOUT);
+#else
+  {
+    chpl_thread_condvar_t* cond;
+    cond = want_full ? &s->signal_full : &s->signal_empty;
+
+    (*parked)++;
+    if (deadline == NULL)
+      (void) pthread_cond_wait(cond, (pthread_mutex_t*) &s->lock);
+    else {
+      struct timespec ts;
+      ts.tv_sec  = deadline->tv_sec;
+      ts.tv_nsec = deadline->tv_usec * 1000UL;
+      timed_out = (pthread_cond_timedwait(cond, (pthread_mutex_t*) &s->lock,
+                                          &ts)
+                   == ETIMEDOUT);
+    }
+    (*parked)--;
   }
+#endif
+
+  return timed_out;
 }
 
-static void chpl_thread_sync_awaken(chpl_sync_aux_t *s) {
-  if (pthread_cond_signal(s->is_full ?
-                          &s->signal_full : &s->signal_empty))
+//
+// Wake one thread parked waiting for the state the sync variable is
+// now in, if there is one.  This is called with the variable's lock
+// held.
+//
+static void sync_wake(chpl_sync_aux_t *s) {
+#ifdef CHPL_SYNC_USE_FUTEX
+  volatile int32_t* seq = s->is_full ? &s->full_seq : &s->empty_seq;
+
+  (*seq)++;
+  if ((s->is_full ? s->parked_full : s->parked_empty) > 0)
+    (void) syscall(SYS_futex, seq, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+#else
+  if ((s->is_full ? s->parked_full : s->parked_empty) > 0
+      && pthread_cond_signal(s->is_full ?
+                             &s->signal_full : &s->signal_empty))
     chpl_internal_error("pthread_cond_signal() failed");
+#endif
 }
 
 void chpl_sync_markAndSignalFull(chpl_sync_aux_t *s) {
   s->is_full = true;
-  chpl_thread_sync_awaken(s);
+  sync_wake(s);
   chpl_sync_unlock(s);
 }
 
 void chpl_sync_markAndSignalEmpty(chpl_sync_aux_t *s) {
   s->is_full = false;
-  chpl_thread_sync_awaken(s);
+  sync_wake(s);
   chpl_sync_unlock(s);
 }
 
@@ -278,18 +384,28 @@ chpl_bool chpl_sync_isFull(void *val_ptr,
   return s->is_full;
 }
 
+#ifndef CHPL_SYNC_USE_FUTEX
 static void chpl_thread_condvar_init(chpl_thread_condvar_t* cv) {
   if (pthread_cond_init((pthread_cond_t*) cv, NULL))
     chpl_internal_error("pthread_cond_init() failed");
 }
+#endif
 
 void chpl_sync_initAux(chpl_sync_aux_t *s) {
   s->is_full = false;
   chpl_thread_mutexInit(&s->lock);
+#ifdef CHPL_SYNC_USE_FUTEX
+  s->full_seq = 0;
+  s->empty_seq = 0;
+#else
   chpl_thread_condvar_init(&s->signal_full);
   chpl_thread_condvar_init(&s->signal_empty);
+#endif
+  s->parked_full = 0;
+  s->parked_empty = 0;
 }
 
+#ifndef CHPL_SYNC_USE_FUTEX
 static void chpl_thread_condvar_destroy(chpl_thread_condvar_t* cv) {
 // Leak condvars on cygwin. Some bug results from condvars still being used at
 // this point on cygwin. For now, just leak them to avoid errors as a result of
@@ -299,10 +415,13 @@ static void chpl_thread_condvar_destroy(chpl_thread_condvar_t* cv) {
     chpl_internal_error("pthread_cond_destroy() failed");
 #endif
 }
+#endif
 
 void chpl_sync_destroyAux(chpl_sync_aux_t *s) {
+#ifndef CHPL_SYNC_USE_FUTEX
   chpl_thread_condvar_destroy(&s->signal_full);
   chpl_thread_condvar_destroy(&s->signal_empty);
+#endif
   chpl_thread_mutexDestroy(&s->lock);
 }
 
@@ -355,6 +474,17 @@ void chpl_task_init(void) {
   extra_task_cnt = 0;
   task_pool_head = task_pool_tail = NULL;
 
+  {
+    char* p;
+
+    if ((p = getenv("CHPL_RT_SYNC_SPIN")) != NULL) {
+      if (sscanf(p, "%" SCNi32, &sync_spin_polls) != 1 || sync_spin_polls < 0)
+        chpl_error("CHPL_RT_SYNC_SPIN must be an integer >= 0", 0, 0);
+    }
+  }
+  atomic_init_uint_least64_t(&sync_spin_waits, 0);
+  atomic_init_uint_least64_t(&sync_parks, 0);
+
   chpl_thread_init(thread_begin, thread_end);
 
   //
@@ -925,6 +1055,16 @@ int32_t  chpl_task_getNumBlockedTasks(void) {
     return 0;
 }
 
+uint64_t chpl_task_getNumSyncSpinWaits(void) {
+  return atomic_load_explicit_uint_least64_t(&sync_spin_waits,
+                                             memory_order_relaxed);
+}
+
+uint64_t chpl_task_getNumSyncParks(void) {
+  return atomic_load_explicit_uint_least64_t(&sync_parks,
+                                             memory_order_relaxed);
+}
+
 
 // Internal utility functions for task management
 
@@ -793,6 +793,14 @@ int32_t chpl_task_getNumBlockedTasks(void) {
   return 0;
 }
 
+uint64_t chpl_task_getNumSyncSpinWaits(void) {
+  return 0;
+}
+
+uint64_t chpl_task_getNumSyncParks(void) {
+  return 0;
+}
+
 
 // Threads
 
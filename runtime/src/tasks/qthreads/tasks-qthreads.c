@@ -1140,6 +1140,16 @@ int32_t chpl_task_getNumBlockedTasks(void)
     return 0;
 }
 
+uint64_t chpl_task_getNumSyncSpinWaits(void)
+{
+    return 0;
+}
+
+uint64_t chpl_task_getNumSyncParks(void)
+{
+    return 0;
+}
+
 // Threads
 
 uint32_t chpl_task_getNumThreads(void)
@@ -0,0 +1 @@
+writeln("Hello");
@@ -0,0 +1,11 @@
+// The same names are looked up again and again from the same scopes, so
+// the visible function cache should both miss and hit.
+proc double(x: int) return 2 * x;
+proc double(x: real) return 2 * x;
+
+var sum = 0.0;
+for i in 1..10 {
+  sum += double(i);
+  sum += double(i:real);
+}
+writeln(sum);
@@ -0,0 +1,68 @@
+use HashedDist, CommDiagnostics;
+
+config const n = 10000;
+
+var D: domain(int) dmapped Hashed(idxType=int);
+
+for i in 1..n by 2 do
+  D += i;
+
+var A: [D] int;
+
+// Every iteration should run on the locale owning its index
+var allLocal = true;
+forall (i, a) in zip(D, A) with (&& reduce allLocal) {
+  allLocal &&= here == D.dist.idxToLocale(i) && a.locale == here;
+  a = i;
+}
+writeln("owner-computes: ", allLocal);
+writeln("size: ", D.size, " sum: ", + reduce A);
+
+// Adding all of 1..n at once should take a couple of on-statements per
+// locale, not one per index
+const Keys = [i in 1..n] i;
+resetCommDiagnostics();
+startCommDiagnostics();
+const numAdded = D.bulkAdd(Keys);
+stopCommDiagnostics();
+const numOns = + reduce [c in getCommDiagnostics()] (c.execute_on +
+                                                     c.execute_on_fast +
+                                                     c.execute_on_nb);
+writeln("bulkAdd added: ", numAdded, " size: ", D.size);
+writeln("bulkAdd on-statements bounded by locales: ", numOns <= 2*numLocales);
+
+const Present = D.bulkMember([0, 1, 2, n, n+1]);
+writeln("bulkMember: ", Present);
+
+for i in 1..n by 3 do
+  D -= i;
+writeln("after removes: ", D.size, " ", D.member(1), " ", D.member(2));
+
+// Elements survive the domain growing and shrinking around them
+var ok = true;
+for i in D do
+  ok &&= if i % 2 == 1 then A[i] == i else A[i] == 0;
+writeln("elements preserved: ", ok);
+
+A[2] = 42;
+writeln("A[2]: ", A[2]);
+
+// String indices hash and compare by content, wherever they came from
+var S: domain(string) dmapped Hashed(idxType=string);
+var Counts: [S] int;
+coforall loc in Locales with (ref S) do on loc {
+  for w in ["apple", "banana", "cherry", "banana"] do
+    S += w;
+}
+forall (s, c) in zip(S, Counts) do
+  c = s.length;
+for s in S.sorted() do
+  writeln(s, " ", Counts[s]);
+
+var T: domain(string) dmapped Hashed(idxType=string);
+T = S;
+T -= "banana";
+writeln(T.sorted());
+
+D.clear();
+writeln("after clear: ", D.size);
@@ -1,6 +1,9 @@
-enum DistType { default };
+use HashedDist;
 
-config param distType: DistType = DistType.default;
+enum DistType { default, hashed };
+
+config param distType: DistType = if CHPL_COMM=="none" then DistType.default
+                                                       else DistType.hashed;
 
 config type intType = int;
 config type uintType = uint(64);
@@ -16,6 +19,15 @@ proc setupDistributions() {
             defaultDist
            );
   }
+  if distType == DistType.hashed {
+    return (
+            new dmap(new Hashed(idxType=intType)),
+            new dmap(new Hashed(idxType=uintType)),
+            new dmap(new Hashed(idxType=realType)),
+            new dmap(new Hashed(idxType=stringType))
+           );
+  }
+  halt("unexpected 'distType': ", distType);
 }
 
 const (DistIntType, DistUintType, DistRealType, DistStringType) = setupDistributions();
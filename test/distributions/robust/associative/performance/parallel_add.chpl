@@ -0,0 +1,42 @@
+use Time;
+
+config const printTiming = false;
+
+// Add n indices, numDistinct of them distinct, to a parSafe domain from
+// every task at once, then remove every other one the same way.
+config const n = 100000;
+config const numDistinct = 50000;
+
+var AD: domain(int, parSafe=true);
+
+{
+  var timer: Timer;
+  timer.start();
+  forall i in 1..n with (ref AD) {
+    AD += i % numDistinct;
+  }
+  timer.stop();
+
+  var ok = AD.size == numDistinct;
+  for i in 0..#numDistinct do
+    ok &&= AD.member(i);
+
+  writeln("Parallel add: ", if ok then "SUCCESS" else "FAILED");
+  if printTiming then writeln("Add: ", timer.elapsed());
+}
+
+{
+  var timer: Timer;
+  timer.start();
+  forall i in 0..#numDistinct by 2 with (ref AD) {
+    AD -= i;
+  }
+  timer.stop();
+
+  var ok = AD.size == numDistinct / 2;
+  for i in 0..#numDistinct do
+    ok &&= AD.member(i) == (i % 2 == 1);
+
+  writeln("Parallel remove: ", if ok then "SUCCESS" else "FAILED");
+  if printTiming then writeln("Remove: ", timer.elapsed());
+}
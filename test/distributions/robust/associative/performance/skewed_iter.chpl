@@ -0,0 +1,87 @@
+use Time;
+
+config const printTiming = false;
+
+// Fill the table to just under half full, then delete every index that
+// is not in the first keepFraction of the table's slots.  What is left
+// is packed into the front of the table with nothing behind it.
+config const n = 3000;
+config const keepFraction = 0.4;
+
+// Work done per index, so that the cost of a chunk of slots tracks the
+// number of full slots in it rather than the number of slots.
+config const work = 100;
+
+var AD: domain(int);
+
+for i in 1..n do
+  AD += i;
+
+// Serial iteration visits the indices in slot order.
+var slotOrder: [0..#n] int;
+var next = 0;
+
+for i in AD {
+  slotOrder[next] = i;
+  next += 1;
+}
+
+for i in slotOrder[(n*keepFraction):int..] do
+  AD -= i;
+
+proc f(i: int) {
+  var x = i;
+  for 1..work do
+    x = (x * 1103515245 + 12345) % 2147483648;
+  return x;
+}
+
+var expected = 0;
+for i in AD do
+  expected += f(i);
+
+var A: [AD] int;
+
+//
+// STANDALONE
+//
+
+{
+  var timer: Timer;
+  timer.start();
+  forall i in AD {
+    A[i] = f(i);
+  }
+  timer.stop();
+
+  var total = 0;
+  for a in A do
+    total += a;
+
+  writeln("Skewed domain iteration: ",
+          if total == expected then "SUCCESS" else "FAILED");
+  if printTiming then writeln("Standalone: ", timer.elapsed());
+}
+
+//
+// LEADER/FOLLOWER
+//
+
+A = 0;
+
+{
+  var timer: Timer;
+  timer.start();
+  forall (i, a) in zip(AD, A) {
+    a = f(i);
+  }
+  timer.stop();
+
+  var total = 0;
+  for a in A do
+    total += a;
+
+  writeln("Skewed zippered iteration: ",
+          if total == expected then "SUCCESS" else "FAILED");
+  if printTiming then writeln("Zippered: ", timer.elapsed());
+}
@@ -0,0 +1,78 @@
+/*
+ *  Check sort() on Block-distributed arrays, comparing each result against
+ *  sorting a local copy with quickSort.
+ */
+
+use Sort;
+use Random;
+use BlockDist;
+
+config const n = 200000;
+
+proc main() {
+  const D = {1..n} dmapped Block({1..n}),
+        smallD = {1..1000} dmapped Block({1..1000}),
+        // Most indices fall outside the bounding box, so the first and
+        // last locales own far more than the others
+        unevenD = {1..n} dmapped Block({1..n/100});
+
+  // Every locale appears several times among the target locales
+  var repLocs: [0..#4*numLocales] locale;
+  for i in repLocs.domain do
+    repLocs[i] = Locales[i % numLocales];
+  const repD = {1..n} dmapped Block({1..n}, targetLocales=repLocs);
+
+  {
+    var A: [D] int;
+    fillRandom(A, seed=42);
+    check(A, 'random int', defaultComparator);
+  }
+
+  {
+    var A: [D] real;
+    fillRandom(A, seed=42);
+    check(A, 'random real, reversed', reverseComparator);
+  }
+
+  {
+    var A: [D] int;
+    fillRandom(A, seed=42);
+    A = A % 3;
+    check(A, 'repeated int', defaultComparator);
+  }
+
+  {
+    var A: [unevenD] int;
+    fillRandom(A, seed=42);
+    check(A, 'uneven blocks', defaultComparator);
+  }
+
+  {
+    var A: [repD] int;
+    fillRandom(A, seed=42);
+    check(A, 'repeated target locales', defaultComparator);
+  }
+
+  {
+    var A: [smallD] string;
+    var R: [smallD] int;
+    fillRandom(R, seed=42);
+    A = (R % 1000): string;
+    check(A, 'small string', defaultComparator);
+  }
+}
+
+proc check(const ref A, name, cmp) {
+  var B = A;
+  var Ref: [0..#A.size] A.eltType = A;
+
+  quickSort(Ref, comparator=cmp);
+  sort(B, comparator=cmp);
+
+  var same = true;
+  for (b, r) in zip(B, Ref) do
+    if chpl_compare(b, r, cmp) != 0 then
+      same = false;
+
+  writeln(name, ': ', if same then 'SUCCESS' else 'FAILED');
+}
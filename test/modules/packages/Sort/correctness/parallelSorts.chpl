@@ -0,0 +1,109 @@
+/*
+ *  Check radixSort, sampleSort and sort() on arrays large enough for them
+ *  to sort in parallel, comparing each result against quickSort.
+ */
+
+use Sort;
+use Random;
+
+config const n = 100000;
+
+proc main() {
+  const D = {1..n},
+        stridedD = {1..2*n by 2};
+
+  testSorts(D, int, defaultComparator);
+  testSorts(D, int(32), defaultComparator);
+  testSorts(D, uint(8), defaultComparator);
+  testSorts(D, real, defaultComparator);
+  testSorts(D, real(32), defaultComparator);
+  testSorts(stridedD, int, defaultComparator);
+  testSorts(D, int, new AbsKeyCmp());
+  testSorts(D, real, new AbsKeyCmp());
+
+  testSampleSorts(D, int, reverseComparator);
+  testSampleSorts(D, int, new AbsCompCmp());
+  testSampleSorts(D, int, new TupleCmp());
+  testSampleSorts(stridedD, real, reverseComparator);
+
+  // Many repeated values exercise sampleSort's equality buckets
+  {
+    var A: [D] int;
+    fillRandom(A, seed=17);
+    A = A % 5;
+    check(A, 'sampleSort', 'repeated int', defaultComparator);
+  }
+
+  // sort() of strings goes through sampleSort
+  {
+    var A: [D] string;
+    var R: [D] int;
+    fillRandom(R, seed=23);
+    [i in D] A[i] = (R[i] % 100000):string;
+    check(A, 'sort', 'string', defaultComparator);
+  }
+}
+
+proc testSorts(D, type eltType, cmp) {
+  var A: [D] eltType;
+  fill(A);
+  check(A, 'radixSort', eltType:string, cmp);
+  check(A, 'sampleSort', eltType:string, cmp);
+  check(A, 'sort', eltType:string, cmp);
+}
+
+proc testSampleSorts(D, type eltType, cmp) {
+  var A: [D] eltType;
+  fill(A);
+  check(A, 'sampleSort', eltType:string, cmp);
+  check(A, 'sort', eltType:string, cmp);
+}
+
+proc fill(A: [] ?eltType) {
+  if isRealType(eltType) {
+    var R: [A.domain] real;
+    fillRandom(R, seed=42);
+    [i in A.domain] A[i] = (R[i] * 2000 - 1000): eltType;
+  } else {
+    var R: [A.domain] int;
+    fillRandom(R, seed=42);
+    [i in A.domain] A[i] = R[i]: eltType;
+  }
+}
+
+proc check(const ref A, sortName, eltName, cmp) {
+  var B = A,
+      Ref = A;
+
+  quickSort(Ref, comparator=cmp);
+
+  select sortName {
+    when 'radixSort' do
+      if chpl_radixSortable(cmp, A.eltType) then radixSort(B, comparator=cmp);
+    when 'sampleSort' do sampleSort(B, comparator=cmp);
+    when 'sort' do sort(B, comparator=cmp);
+  }
+
+  var same = true;
+  for (b, r) in zip(B, Ref) do
+    if chpl_compare(b, r, cmp) != 0 then
+      same = false;
+
+  writeln(sortName, ' ', eltName, ' ', cmp.type:string, ': ',
+          if same && isSorted(B, comparator=cmp) then 'SUCCESS' else 'FAILED');
+}
+
+/* Key Sort by absolute value */
+record AbsKeyCmp {
+  proc key(a) { return abs(a); }
+}
+
+/* Compare Sort by absolute value */
+record AbsCompCmp {
+  proc compare(a, b) { return abs(a) - abs(b); }
+}
+
+/* Key method returning a tuple */
+record TupleCmp {
+  proc key(a) { return (a % 10, a); }
+}
@@ -0,0 +1,67 @@
+/*
+    Performance test of the parallel sort routines. Sorts 2**M bytes of
+    random data. Vary the number of tasks with --dataParTasksPerLocale.
+
+    Note: The correctness test for this is simply checking that it compiles and
+          runs without errors
+ */
+
+use Sort;
+use Random;
+use Time;
+
+config const M: int = 20,                   // 2**M bytes
+             correctness: bool = true,      // Disables output
+             sorts: string = 'rsaq';        // Sorts to use (see below)
+
+// Type of array
+config type T = int;
+
+// Number of elements
+const N: int = (2**M / numBytes(T)): int;
+
+proc main() {
+  const D = {1..N};
+  var A: [D] T;
+  fillRandom(A, seed=42);
+
+  print('Time taken to sort ', 2**M, ' bytes (', A.size, ' ', T:string,
+        's) with ', if dataParTasksPerLocale == 0 then here.maxTaskPar
+                    else dataParTasksPerLocale, ' tasks');
+
+  if sorts.find('r') then
+    timeSort(A, 'radixSort');
+  if sorts.find('s') then
+    timeSort(A, 'sampleSort');
+  if sorts.find('a') then
+    timeSort(A, 'sampleSort (reverse)');
+  if sorts.find('q') then
+    timeSort(A, 'quickSort');
+}
+
+proc timeSort(const ref A, name) {
+  var t = new Timer();
+  var B = A;
+
+  t.start();
+  select name {
+    when 'radixSort' do radixSort(B);
+    when 'sampleSort' do sampleSort(B);
+    when 'sampleSort (reverse)' do sampleSort(B, comparator=reverseComparator);
+    when 'quickSort' do quickSort(B);
+  }
+  t.stop();
+
+  const sorted = if name == 'sampleSort (reverse)'
+                 then isSorted(B, comparator=reverseComparator)
+                 else isSorted(B);
+  if !sorted then
+    writeln(name, ' failed to sort data');
+  else
+    print(name, ' (seconds): ', t.elapsed());
+}
+
+proc print(args...) {
+  if !correctness then
+    writeln((...args));
+}
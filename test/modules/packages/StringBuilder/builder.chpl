@@ -0,0 +1,44 @@
+use StringBuilder, Memory;
+
+// Building a string piece by piece
+var sb: StringBuilder;
+sb.append("key", ":", 42, ":", 1.5, ":", true);
+sb += '/';
+sb += 7;
+writeln(sb, " (", sb.length, " bytes)");
+
+// toString copies the contents out, leaving the builder as it was
+const s = sb.toString();
+sb.append("!");
+writeln(s);
+writeln(sb);
+
+// Clearing keeps the buffer for reuse
+sb.clear();
+sb.append("reused");
+writeln(sb.toString());
+
+// Integers are formatted in place
+sb.clear();
+sb.append(0, " ", -17, " ", max(int), " ", min(int), " ", max(uint), " ",
+          42:int(8), " ", min(int(8)), " ", 255:uint(8));
+writeln(sb);
+
+// A reserved builder appends strings and integers without allocating
+var reserved = new StringBuilder(64);
+const piece = "abcd";
+const before = memoryAllocations();
+for i in 1..8 do reserved.append(piece, i);
+writeln("allocations while appending: ", memoryAllocations() - before);
+writeln(reserved.length);
+
+// Single-character strings share a static buffer
+const word = "hello";
+const beforeChars = memoryAllocations();
+var count = 0;
+for c in word do
+  if c == "l" then count += 1;
+const h = word[1];
+writeln("allocations for single characters: ",
+        memoryAllocations() - beforeChars);
+writeln(count, " ", h, " ", h.toUpper(), " ", asciiToString(0x21));
@@ -0,0 +1,65 @@
+/*
+    Performance test of building many short string keys.  Compares
+    concatenating the pieces with ``+`` against appending them to a
+    StringBuilder, in time and in the number of allocations performed.
+
+    Note: The correctness test for this is simply checking that both
+          approaches build the same keys.  Allocation counts are only
+          reported with --countAllocs, which needs --memTrack.  Since
+          --memTrack slows every allocation, time without it.
+ */
+
+use StringBuilder;
+use Memory;
+use Time;
+
+config const n = 1000,
+             correctness = true,      // Disables timing output
+             countAllocs = false;     // Report allocations, not times
+
+proc main() {
+  const prefixes = ["alpha", "beta", "gamma", "delta"];
+  var concatKeys, builderKeys: [1..n] string;
+
+  var t = new Timer();
+  var allocs = startAllocs();
+
+  t.start();
+  for i in 1..n {
+    const p = prefixes[i%4 + 1];
+    concatKeys[i] = p + ":" + i + ":" + p.length;
+  }
+  t.stop();
+  report('concat', t, allocs);
+
+  t.start();
+  var sb: StringBuilder;
+  for i in 1..n {
+    const p = prefixes[i%4 + 1];
+    sb.clear();
+    sb.append(p, ":", i, ":", p.length);
+    builderKeys[i] = sb.toString();
+  }
+  t.stop();
+  report('builder', t, allocs);
+
+  for i in 1..n do
+    if concatKeys[i] != builderKeys[i] then
+      writeln('builder disagrees with concatenation: ', concatKeys[i],
+              ' vs ', builderKeys[i]);
+}
+
+proc startAllocs() {
+  return if countAllocs then memoryAllocations() else 0:uint(64);
+}
+
+proc report(name, ref t, ref allocs) {
+  if countAllocs {
+    const now = memoryAllocations();
+    writeln(name, ' (allocations): ', now - allocs);
+    allocs = memoryAllocations();
+  } else if !correctness {
+    writeln(name, ' (seconds): ', t.elapsed());
+  }
+  t.clear();
+}
@@ -0,0 +1,64 @@
+// Products and transposes of Block-distributed matrices
+use LinearAlgebra, BlockDist, CommDiagnostics;
+
+config const m = 70, k = 300, n = 90;
+config const printComms = false;
+
+proc check(type t, AD, BD, targetLocs: [] locale = Locales) {
+  const ADist = AD dmapped Block(boundingBox=AD, targetLocales=targetLocs),
+        BDist = BD dmapped Block(boundingBox=BD, targetLocales=targetLocs);
+  var A: [ADist] t, B: [BDist] t;
+  var ALoc: [AD] t, BLoc: [BD] t;
+
+  forall ((i, j), a) in zip(ADist, A) do a = ((i * 7 + j * 3) % 11 - 5): t;
+  forall ((i, j), b) in zip(BDist, B) do b = ((i * 5 + j) % 13 - 6): t;
+  ALoc = A;
+  BLoc = B;
+
+  resetCommDiagnostics();
+  startCommDiagnostics();
+  const C = dot(A, B);
+  stopCommDiagnostics();
+  const multComms = + reduce [c in getCommDiagnostics()] (c.get + c.put);
+
+  resetCommDiagnostics();
+  startCommDiagnostics();
+  const AT = transpose(A);
+  stopCommDiagnostics();
+  const transComms = + reduce [c in getCommDiagnostics()] (c.get + c.put);
+
+  var CLoc: [AD.dim(1), BD.dim(2)] t;
+  for (i, j) in CLoc.domain do
+    for (ak, bk) in zip(AD.dim(2), BD.dim(1)) do
+      CLoc[i, j] += ALoc[i, ak] * BLoc[bk, j];
+
+  writeln(t:string, " ", AD, " x ", BD, ": ",
+          C.domain == {AD.dim(1), BD.dim(2)}, " ",
+          && reduce (C == CLoc), " ",
+          C.targetLocales().equals(A.targetLocales()), " ",
+          && reduce [(i, j) in AD] AT[j, i] == ALoc[i, j], " ",
+          AT.targetLocales().equals(A.targetLocales()));
+
+  if printComms then
+    writeln("  dot: ", multComms, " transpose: ", transComms);
+
+  // Copying element by element would take about one get per element of
+  // the operands
+  if AD.size >= 10000 {
+    if multComms > (AD.size + BD.size) / 10 then
+      writeln("  too many communication events in dot: ", multComms);
+    if transComms > AD.size / 10 then
+      writeln("  too many communication events in transpose: ", transComms);
+  }
+}
+
+check(int, {1..m, 1..k}, {1..k, 1..n});
+check(real, {1..m, 1..k}, {1..k, 1..n});
+check(real, {0..#m, 5..#k}, {-3..#k, 2..#n});
+check(int, {1..2, 1..3}, {1..3, 1..1});
+
+// A locale may appear more than once among the target locales
+var repLocs: [0..1, 0..1] locale;
+for (i, j) in repLocs.domain do
+  repLocs[i, j] = Locales[(i + j) % numLocales];
+check(real, {1..m, 1..k}, {1..k, 1..n}, repLocs);
@@ -0,0 +1,43 @@
+// Matrix products using the native kernels, checked against simple loops
+use LinearAlgebra;
+
+config const m = 70, k = 260, n = 260;
+
+proc reference(A: [?AD] ?t, B: [?BD] t) {
+  var C: [AD.dim(1), BD.dim(2)] t;
+  for (i, j) in C.domain do
+    for (ak, bk) in zip(AD.dim(2), BD.dim(1)) do
+      C[i, j] += A[i, ak] * B[bk, j];
+  return C;
+}
+
+proc check(type t, AD, BD) {
+  var A: [AD] t, B: [BD] t;
+  for ((i, j), a) in zip(AD, A) do a = ((i * 7 + j * 3) % 11 - 5): t;
+  for ((i, j), b) in zip(BD, B) do b = ((i * 5 + j) % 13 - 6): t;
+
+  const C = dot(A, B);
+  write(t:string, " ", AD, " x ", BD, ": ",
+        C.domain == {AD.dim(1), BD.dim(2)} &&
+        && reduce (C == reference(A, B)));
+
+  var x: [BD.dim(1)] t, y: [AD.dim(1)] t;
+  for (xi, i) in zip(x, 1..) do xi = (i % 4 - 1): t;
+  for (yi, i) in zip(y, 1..) do yi = (i % 3 - 1): t;
+
+  var xMat: [BD.dim(1), 0..0] t, yMat: [0..0, AD.dim(1)] t;
+  for i in BD.dim(1) do xMat[i, 0] = x[i];
+  for i in AD.dim(1) do yMat[0, i] = y[i];
+
+  const Ax = dot(A, x), yA = dot(y, A);
+  const AxRef = reference(A, xMat), yARef = reference(yMat, A);
+  writeln(" ", && reduce [i in AD.dim(1)] Ax[i] == AxRef[i, 0],
+          " ", && reduce [j in AD.dim(2)] yA[j] == yARef[0, j]);
+}
+
+check(int, {1..m, 1..k}, {1..k, 1..n});
+check(real, {1..m, 1..k}, {1..k, 1..n});
+check(int(32), {0..#m, 5..#k}, {-3..#k, 2..#n});
+check(real, {1..2*m by 2, 1..k}, {1..k, 1..n by -1});
+check(int, {1..1, 1..1}, {1..1, 1..1});
+check(real, {1..1, 1..k}, {1..k, 1..1});
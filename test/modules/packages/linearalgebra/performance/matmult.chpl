@@ -0,0 +1,57 @@
+/*
+    Performance test of dense matrix-matrix multiplication.  Compares the
+    naive algorithm LinearAlgebra used for non-BLAS element types, the
+    native blocked kernel that replaced it, and BLAS.
+
+    Note: The correctness test for this is simply checking that the three
+          agree with each other.
+ */
+
+use LinearAlgebra;
+use Random;
+use Time;
+
+config const n = 64,
+             correctness = true;      // Disables timing output
+
+proc main() {
+  var A, B: [1..n, 1..n] real;
+  fillRandom(A, seed=42);
+  fillRandom(B, seed=43);
+
+  var t = new Timer();
+
+  t.start();
+  const naive = naiveMult(A, B);
+  t.stop();
+  report('naive', t);
+
+  t.start();
+  const native = _matmatMultNative(A, B);
+  t.stop();
+  report('native', t);
+
+  t.start();
+  const blas = dot(A, B);
+  t.stop();
+  report('BLAS', t);
+
+  if max reduce abs(naive - native) > 1e-9 * n then
+    writeln('native kernel disagrees with naive algorithm');
+  if max reduce abs(naive - blas) > 1e-9 * n then
+    writeln('BLAS disagrees with naive algorithm');
+}
+
+proc report(name, ref t: Timer) {
+  if !correctness then
+    writeln(name, ' (seconds): ', t.elapsed());
+  t.clear();
+}
+
+// The algorithm LinearAlgebra used for element types without BLAS support
+proc naiveMult(A: [?Adom] ?eltType, B: [?Bdom] eltType) {
+  var C: [Adom.dim(1), Bdom.dim(2)] eltType;
+  forall (i,j) in C.domain do
+    C[i,j] = + reduce (A[i,..]*B[..,j]);
+  return C;
+}
@@ -0,0 +1,100 @@
+use LinearAlgebra, LayoutCSR;
+
+config const n = 23, m = 17;
+
+// An irregular pattern: a few dense rows, many short ones, some empty
+proc isNonzero(i, j) {
+  return i % 7 == 0 || (i * 3 + j * 5) % 11 == 0 || i == j;
+}
+
+proc value(i, j) return i * 100 + j;
+
+const D = {1..n, 0..m-1};
+var inds: [1..0] 2*int;
+for (i, j) in D do
+  if isNonzero(i, j) then inds.push_back((i, j));
+
+var dense: [D] int;
+for (i, j) in inds do dense[i, j] = value(i, j);
+
+var CSRDomain: sparse subdomain(D) dmapped CSR();
+var DefDomain: sparse subdomain(D);
+CSRDomain.bulkAdd(inds);
+DefDomain.bulkAdd(inds);
+
+var CSRMat: [CSRDomain] int;
+var DefMat: [DefDomain] int;
+forall (i, j) in CSRDomain do CSRMat[i, j] = value(i, j);
+forall (i, j) in DefDomain do DefMat[i, j] = value(i, j);
+
+proc denseMatMul(A: [?AD] int, B: [?BD] int) {
+  var C: [AD.dim(1), BD.dim(2)] int;
+  const off = BD.dim(1).low - AD.dim(2).low;
+  for (i, j) in C.domain do
+    for k in AD.dim(2) do
+      C[i, j] += A[i, k] * B[k + off, j];
+  return C;
+}
+
+proc toDense(S: [?SD] int, parentDom) {
+  var M: [parentDom] int;
+  for (i, j) in SD do M[i, j] = S[i, j];
+  return M;
+}
+
+proc check(name, S) {
+  var x: [1..m] int;
+  for i in 1..m do x[i] = i % 5 - 2;
+  var xt: [0..n-1] int;
+  for i in 0..n-1 do xt[i] = i % 3 + 1;
+  var B: [1..m, 1..4] int;
+  for (i, j) in B.domain do B[i, j] = i - j;
+
+  // sparse * dense vector
+  const y = dot(S, x);
+  var yExpected: [1..n] int;
+  for i in 1..n do
+    for j in 0..m-1 do
+      yExpected[i] += dense[i, j] * x[j+1];
+  writeln(name, " spmv:   ", && reduce (y == yExpected));
+
+  // dense vector * sparse
+  const z = dot(xt, S);
+  var zExpected: [0..m-1] int;
+  for j in 0..m-1 do
+    for i in 1..n do
+      zExpected[j] += xt[i-1] * dense[i, j];
+  writeln(name, " vecmat: ", && reduce (z == zExpected));
+
+  // sparse * dense matrix
+  const C = dot(S, B);
+  writeln(name, " spmm:   ", && reduce (C == denseMatMul(dense, B)));
+
+  // transpose
+  const ST = transpose(S);
+  var allMatch = ST.domain.size == S.domain.size;
+  for (j, i) in ST.domain do
+    allMatch &&= ST[j, i] == dense[i, j];
+  writeln(name, " trans:  ", allMatch);
+
+  // sparse * sparse
+  const P = dot(S, ST);
+  var denseT: [0..m-1, 1..n] int;
+  for (i, j) in D do denseT[j, i] = dense[i, j];
+  const PExpected = denseMatMul(dense, denseT);
+  var nnzExpected = 0;
+  for (i, j) in PExpected.domain do
+    if PExpected[i, j] != 0 then nnzExpected += 1;
+  writeln(name, " spgemm: ", && reduce (toDense(P, PExpected.domain) == PExpected),
+          " ", P.domain.size == nnzExpected);
+}
+
+check("CSR", CSRMat);
+check("default", DefMat);
+
+// empty matrices
+var EmptyDom: sparse subdomain(D) dmapped CSR();
+var Empty: [EmptyDom] int;
+var ones: [1..m] int = 1;
+writeln(dot(Empty, ones));
+writeln(transpose(Empty).domain.size, " ", dot(Empty, transpose(Empty)).domain.size);
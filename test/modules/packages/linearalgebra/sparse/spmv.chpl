@@ -0,0 +1,77 @@
+/*
+    Performance test of the sparse matrix-vector product for the default
+    sparse and CSR layouts.  Writes the 5-point Laplacian of an n x n grid
+    as a Matrix Market file, reads it back with mmreadsp, and times
+    repeated products with each layout.
+
+    Note: The correctness test for this is simply checking that the two
+          layouts agree with each other and with the expected row sums.
+ */
+
+use LinearAlgebra, LayoutCSR, MatrixMarket;
+use Time;
+
+config const n = 50,                   // grid is n x n, matrix is n^2 x n^2
+             iterations = 10,
+             correctness = true,       // Disables timing output
+             filename = "spmv.mtx";
+
+proc main() {
+  writeLaplacian(filename);
+
+  const DefMat = mmreadsp(real, filename);
+  const D = {1..n*n, 1..n*n};
+
+  var CSRDomain: sparse subdomain(D) dmapped CSR();
+  var inds: [1..DefMat.domain.size] 2*int;
+  for (idx, ind) in zip(inds, DefMat.domain) do idx = ind;
+  CSRDomain.bulkAdd(inds, dataSorted=true, isUnique=true);
+  var CSRMat: [CSRDomain] real;
+  forall ind in CSRDomain do CSRMat[ind] = DefMat[ind];
+
+  var x: [1..n*n] real = 1.0;
+  const yDef = timeSpMV(DefMat, x, 'default SpMV'),
+        yCSR = timeSpMV(CSRMat, x, 'CSR SpMV');
+
+  // with x == 1, each row sums to 4 minus its number of neighbors
+  var expected: [1..n*n] real;
+  forall i in 1..n*n {
+    const (r, c) = ((i-1) / n, (i-1) % n);
+    expected[i] = (r == 0) + (r == n-1) + (c == 0) + (c == n-1);
+  }
+  if || reduce (yDef != expected) then writeln('default SpMV failed');
+  if || reduce (yCSR != expected) then writeln('CSR SpMV failed');
+}
+
+proc timeSpMV(A, x, name) {
+  var t = new Timer();
+  var y = dot(A, x);
+
+  t.start();
+  for 1..iterations do
+    y = dot(A, x);
+  t.stop();
+
+  if !correctness then
+    writeln(name, ' (seconds): ', t.elapsed() / iterations);
+  return y;
+}
+
+proc writeLaplacian(filename) {
+  const N = n*n;
+  var nnz = 5*N - 4*n;
+  var f = open(filename, iomode.cw);
+  var w = f.writer();
+  w.writeln("%%MatrixMarket matrix coordinate real general");
+  w.writeln(N, " ", N, " ", nnz);
+  for i in 1..N {
+    const (r, c) = ((i-1) / n, (i-1) % n);
+    if r > 0 then w.writeln(i, " ", i-n, " -1.0");
+    if c > 0 then w.writeln(i, " ", i-1, " -1.0");
+    w.writeln(i, " ", i, " 4.0");
+    if c < n-1 then w.writeln(i, " ", i+1, " -1.0");
+    if r < n-1 then w.writeln(i, " ", i+n, " -1.0");
+  }
+  w.close();
+  f.close();
+}
@@ -0,0 +1,22 @@
+use Memory;
+use Vectors;
+
+var mem : uint;
+proc output()
+{
+	mem=memoryUsed();
+	var v : vector(int);
+	for i in 1..100 do
+		v.push_back(i);
+	var c = v;
+	var d : vector(int);
+	d = c;
+	forall (x, y) in zip(v, d) do
+		x += y;
+	v.shrink();
+}
+
+memTrack;
+writeln(memoryUsed());
+output();
+writeln(memoryUsed()-mem);
@@ -0,0 +1,96 @@
+/*
+    Performance test of building a sequence one element at a time and then
+    iterating over it.  Compares a vector against a List and against an
+    array whose domain is grown by doubling.
+
+    Note: The correctness test for this is simply checking that all three
+          containers hold the same elements.
+ */
+
+use Vectors;
+use List;
+use Time;
+
+config const n = 1000,
+             correctness = true;      // Disables timing output
+
+proc main() {
+  var t = new Timer();
+
+  // Building
+  t.start();
+  var l: list(int);
+  for i in 1..n do
+    l.append(i);
+  t.stop();
+  report('list append', t);
+
+  t.start();
+  var D = {1..0};
+  var A: [D] int;
+  var len = 0;
+  for i in 1..n {
+    if len == D.size then
+      D = {1..max(8, 2*len)};
+    len += 1;
+    A[len] = i;
+  }
+  D = {1..len};
+  t.stop();
+  report('array append', t);
+
+  t.start();
+  var v: vector(int);
+  for i in 1..n do
+    v.append(i);
+  t.stop();
+  report('vector append', t);
+
+  // Serial iteration
+  var listSum, arraySum, vectorSum: int;
+
+  t.start();
+  for x in l do
+    listSum += x;
+  t.stop();
+  report('list iterate', t);
+
+  t.start();
+  for x in A do
+    arraySum += x;
+  t.stop();
+  report('array iterate', t);
+
+  t.start();
+  for x in v do
+    vectorSum += x;
+  t.stop();
+  report('vector iterate', t);
+
+  if listSum != arraySum || vectorSum != arraySum then
+    writeln('sums disagree: ', (listSum, arraySum, vectorSum));
+
+  // Parallel update; lists can only be iterated over serially
+  t.start();
+  forall x in A do
+    x *= 2;
+  t.stop();
+  report('array forall', t);
+
+  t.start();
+  forall x in v do
+    x *= 2;
+  t.stop();
+  report('vector forall', t);
+
+  if v.size != n || || reduce [(x, a) in zip(v, A)] x != a then
+    writeln('vector disagrees with array');
+
+  l.destroy();
+}
+
+proc report(name, ref t) {
+  if !correctness then
+    writeln(name, ' (seconds): ', t.elapsed());
+  t.clear();
+}
@@ -0,0 +1,74 @@
+use Vectors;
+
+var v: vector(int);
+writeln(v.size, " ", v.isEmpty(), " ", v, " ", v.capacity);
+
+for i in 1..10 do
+  v.append(i);
+writeln(v, " (", v.size, " of ", v.capacity, ")");
+
+v.append(11, 12, 13);
+v.push_back(14);
+writeln(v.pop_back(), " ", v.back(), " ", v[1], " ", v[v.size]);
+
+// Elements can be modified through indexing and iteration
+v[1] = 100;
+for x in v do x *= 2;
+v.back() = -1;
+writeln(v);
+
+// Bulk appends from arrays and other vectors
+var A = [20, 30, 40];
+v.clear();
+v.append(A);
+v.append(A[2..3]);
+var w = makeVector(1, 2, 3);
+v.append(w);
+writeln(v, " ", v.toArray().domain);
+
+// Capacity
+v.reserve(100);
+writeln(v.size, " ", v.capacity);
+v.shrink();
+writeln(v.size, " ", v.capacity);
+
+// Copies are independent
+var c = v;
+c[1] = 0;
+var d: vector(int);
+d = v;
+d.append(99);
+writeln(v, " | ", c, " | ", d);
+
+// ... including copies made into tuples, in-intent formals and fields
+var t = (v, 1);
+t(1)(1) = 99;
+proc f(in x: vector(int)) {
+  x(2) = 77;
+  return x(2);
+}
+class C {
+  var f: vector(int);
+}
+var obj = new C(v);
+obj.f(3) = 55;
+writeln(v, " | ", t(1), " | ", f(v), " | ", obj.f);
+delete obj;
+
+// Parallel iteration, alone and zippered with arrays
+var big: vector(real);
+for i in 1..1000 do big.append(i);
+forall x in big do x = -x;
+writeln(+ reduce big);
+var B: [1..1000] real;
+forall (b, x) in zip(B, big) do b = 2*x;
+writeln(+ reduce B);
+forall (x, b) in zip(big, B) do x += b;
+writeln(+ reduce big, " ", big[1000]);
+
+// Vectors of non-numeric types
+var s = makeVector("one", "two");
+s.append("three");
+writeln(s, " ", s.size);
+var fromArr = makeVector(["x", "y"]);
+writeln(fromArr, " ", fromArr.size);
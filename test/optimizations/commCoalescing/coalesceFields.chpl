@@ -0,0 +1,44 @@
+use BlockDist;
+
+record R {
+  var x, y, z: real;
+  var id: int;
+}
+
+config const n = 100;
+
+const D = {1..n} dmapped Block({1..n});
+var A: [D] R;
+
+forall i in D do
+  A[i] = new R(i, 2*i, 3*i, i);
+
+var sum, xs: real;
+
+on Locales[numLocales-1] {
+  // the three reads of r are fetched with one get
+  for i in 1..n {
+    ref r = A[i];
+    sum += r.x + r.y + r.z;
+  }
+
+  // only one field is read, so nothing to coalesce
+  for i in 1..n {
+    ref r = A[i];
+    xs += r.x;
+  }
+
+  // r.x is read before the store through r, and r.id is read by the
+  // store itself, so those two are coalesced; the read of r.y after the
+  // store is not
+  for i in 1..n {
+    ref r = A[i];
+    const x = r.x;
+    r.id = -r.id;
+    xs += x + r.y;
+  }
+}
+
+writeln(sum);
+writeln(xs);
+writeln(+ reduce A.id);
@@ -0,0 +1,46 @@
+// Locals referenced by on statements are moved to the heap when the
+// comm layer cannot reach task stacks.  Check that structured uses are
+// freed at the end of their scope and that begins keep them alive.
+
+proc bump(ref y: int) {
+  y += 1;
+  if y > 100 then
+    begin writeln("big");
+}
+
+proc structured() {
+  var sum = 0;
+  on Locales[numLocales-1] do sum += 1;
+
+  var total = 0;
+  coforall loc in Locales with (ref total) do
+    on loc do total += 2;
+
+  // bump() starts a begin, but sum never reaches it
+  bump(sum);
+
+  writeln(sum, " ", total == 2*numLocales);
+}
+
+proc unstructured() {
+  var x = 0;
+  sync {
+    begin with (ref x) on Locales[numLocales-1] do x = 7;
+  }
+  writeln(x);
+}
+
+// The address of y is handed to C, which could keep it, so y can't be
+// freed with its scope.
+extern proc memset(ref s: int, c: c_int, n: size_t): c_void_ptr;
+
+proc toC() {
+  var y = 0;
+  on Locales[numLocales-1] do y = 5;
+  memset(y, 0, 0);
+  writeln(y);
+}
+
+structured();
+unstructured();
+toC();
@@ -0,0 +1,25 @@
+// Compiled with the counts from an instrumented run of itself (see
+// hotCalls.precomp), the hot helper is inlined into the loop that calls
+// it, the hot recursive function is not, and the cold one is left alone.
+config const n = 100000;
+
+proc step(x: int): int {
+  return (x * 1103515245 + 12345) % 2147483648;
+}
+
+proc fib(k: int): int {
+  if k < 2 then return k;
+  return fib(k-1) + fib(k-2);
+}
+
+proc checksum(x: int): int {
+  return x % 1000;
+}
+
+var s = 1;
+
+for i in 1..n do
+  s = step(s);
+
+writeln(checksum(s));
+writeln(fib(20));
@@ -0,0 +1,41 @@
+/*
+This test times a 5-point Jacobi stencil over a grid whose rows are too
+long for three of them to stay in cache.  Without tiling, the row above
+the current one has been evicted by the time it is reused as the current
+row and again as the row below; tiling with --dataParTileSize keeps the
+neighborhood of each tile in cache.  Compare runs with
+--dataParTileSize=0 and --dataParTileSize=-1.
+*/
+
+use Time;
+
+config const perf = false; // performance or --fast mode
+config const reportTime = perf;
+
+config const rows = if perf then 16 else 20,
+             cols = if perf then 2000000 else 30;
+config const iters = if perf then 10 else 2;
+
+const Grid = {0..rows+1, 0..cols+1},
+      Inner = Grid.expand(-1);
+
+var A, B: [Grid] real;
+
+forall (i, j) in Grid do
+  A[i, j] = (i * 7 + j * 3) % 10;
+
+var timer: Timer;
+timer.start();
+for it in 1..iters {
+  forall (i, j) in Inner do
+    B[i, j] = (A[i-1, j] + A[i+1, j] + A[i, j-1] + A[i, j+1] + A[i, j]) / 5;
+  forall (i, j) in Inner do
+    A[i, j] = (B[i-1, j] + B[i+1, j] + B[i, j-1] + B[i, j+1] + B[i, j]) / 5;
+}
+timer.stop();
+
+writeln("Stencil checksum: ", + reduce A[Inner]);
+if reportTime {
+  writeln("Tile size: ", dataParTileSize);
+  writeln("Stencil time (s): ", timer.elapsed());
+}
@@ -0,0 +1,42 @@
+use BlockDist;
+
+// The iteration order of a forall over a 2D domain, run on one task
+// with 2x2 tiles, for both the standalone and leader/follower paths.
+var D = {1..4, 1..5};
+var order, zipOrder: [D] int;
+var cnt: atomic int;
+
+forall ij in D do
+  order[ij] = cnt.fetchAdd(1);
+writeln(order);
+
+cnt.write(0);
+forall (o, ij) in zip(zipOrder, D) do
+  o = cnt.fetchAdd(1);
+writeln(&& reduce (zipOrder == order));
+
+// Tiled results must not depend on the tile size or the distribution.
+proc check(A, B) {
+  forall (i, j) in A.domain do
+    A[i, j] = i * 1000 + j;
+  forall (b, (i, j)) in zip(B, B.domain) do
+    b = A[j, i];
+  return && reduce [(i, j) in B.domain] B[i, j] == A[j, i];
+}
+
+var L: [1..9, 1..9] int, LT: [1..9, 1..9] int;
+writeln(check(L, LT));
+
+const BD = {1..9, 1..9} dmapped Block({1..9, 1..9});
+var BA, BT: [BD] int;
+writeln(check(BA, BT));
+
+var S: [1..12 by 3, 2..10 by -2] int;
+forall (i, j) in S.domain do
+  S[i, j] = i + j;
+writeln(S);
+
+var R3: [1..3, 1..4, 1..5] int;
+forall (a, (i, j, k)) in zip(R3, R3.domain) do
+  a = i * 100 + j * 10 + k;
+writeln(+ reduce R3);
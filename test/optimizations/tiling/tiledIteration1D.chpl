@@ -0,0 +1,21 @@
+// Tiling only applies to multi-dimensional iteration: a one-dimensional
+// leader hands each task its whole block, whatever dataParTileSize is.
+var calls: atomic int;
+
+iter counted(n: int) {
+  for i in 1..n do
+    yield i;
+}
+
+iter counted(param tag: iterKind, n: int, followThis)
+  where tag == iterKind.follower {
+  calls.add(1);
+  for i in followThis(1) do
+    yield i+1;
+}
+
+var A: [1..10] int;
+forall (a, c) in zip(A, counted(10)) do
+  a = c;
+writeln(A);
+writeln(calls.read());
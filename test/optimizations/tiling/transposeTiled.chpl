@@ -0,0 +1,45 @@
+/*
+This test times an out-of-place matrix transpose, B = A^T, written as a
+forall over the destination's domain.  Without tiling each task walks
+whole rows of B, so every read of A touches a new cache line; with
+--dataParTileSize the rows and columns of each task's block are walked
+in tiles that stay in cache.  Compare runs with --dataParTileSize=0 and
+--dataParTileSize=-1 (tile size chosen from --dataParTileCacheBytes).
+*/
+
+use Time;
+
+config const perf = false; // performance or --fast mode
+config const reportTime = perf;
+
+config const n = if perf then 4096 else 100;
+config const trials = if perf then 5 else 1;
+
+const DA = {1..n, 1..n};
+var A, B: [DA] real;
+
+forall (i, j) in DA do
+  A[i, j] = (i - 1) * n + j;
+
+var timer: Timer;
+var best = max(real);
+
+for t in 1..trials {
+  timer.clear();
+  timer.start();
+  forall (i, j) in DA do
+    B[i, j] = A[j, i];
+  timer.stop();
+  best = min(best, timer.elapsed());
+}
+
+var ok = true;
+forall (i, j) in DA with (&& reduce ok) do
+  ok &&= B[i, j] == (j - 1) * n + i;
+
+writeln("Transpose verified: ", ok);
+if reportTime {
+  writeln("Tile size: ", dataParTileSize);
+  writeln("Transpose time (s): ", best);
+  writeln("Transpose bandwidth (GB/s): ", 2 * n * n * 8 / best / 1e9);
+}
@@ -0,0 +1,88 @@
+/*
+This test measures what combining coforall+on task completions through
+per-locale leaves (see _endCountLeavesAlloc() in ChapelBase) costs or
+saves.  It is compiled and run so that every bounded coforall+on with
+more than one task per locale combines, whatever the number of locales.
+An unbounded coforall+on never combines, so it serves as the baseline.
+
+For each task count in 1, 2, 4, ... maxTasksPerLocale it times M reps of
+  - a bounded coforall+on of numLocales*tasks tasks, spread evenly
+    across the locales
+  - the same loop over an iterator of unknown size
+
+The largest number of locales at which the combined loops still lose is
+where endCountCombineCrossover should be.
+*/
+
+use Time;
+
+config const perf = false; // performance or --fast mode
+config const reportTime = perf;
+
+config const maxTasksPerLocale = if perf then 64 else 4;
+config const M = if perf then 100 else 2;
+
+var timer: Timer;
+var numFailures = 0;
+
+proc end(testName: string, tasks: int, numErrors: int) {
+  const elapsed = if reportTime then timer.elapsed() + " sec" else "";
+  const message = if numErrors then numErrors + " FAILURES: " else "success  ";
+  writeln(message, testName, " ", tasks, " tasks/locale: ", elapsed);
+  if numErrors then numFailures += 1;
+}
+
+iter unsized(n: int) {
+  for i in 0..#n do yield i;
+}
+
+proc combined(tasks: int) {
+  var numErrors = 0;
+
+  timer.clear();
+  timer.start();
+  for rep in 1..M {
+    var count: atomic int;
+
+    coforall i in 0..#numLocales*tasks do on Locales[i%numLocales] do
+      count.add(1);
+
+    if count.read() != numLocales * tasks then
+      numErrors += 1;
+  }
+  timer.stop();
+
+  end("combined coforall-on", tasks, numErrors);
+}
+
+proc direct(tasks: int) {
+  var numErrors = 0;
+
+  timer.clear();
+  timer.start();
+  for rep in 1..M {
+    var count: atomic int;
+
+    coforall i in unsized(numLocales*tasks) do on Locales[i%numLocales] do
+      count.add(1);
+
+    if count.read() != numLocales * tasks then
+      numErrors += 1;
+  }
+  timer.stop();
+
+  end("direct coforall-on", tasks, numErrors);
+}
+
+proc main() {
+  var tasks = 1;
+
+  while tasks <= maxTasksPerLocale {
+    combined(tasks);
+    direct(tasks);
+    tasks *= 2;
+  }
+
+  if numFailures then writeln(numFailures, " FAILURES");
+  else writeln("all tests succeeded");
+}
@@ -0,0 +1,27 @@
+//
+// Bounded coforall+on loops with more than endCountCombineRatio tasks
+// per locale complete through per-locale leaves of the end count.
+//
+config const tasksPerLocale = 8;
+
+var count: atomic int;
+coforall i in 0..#numLocales*tasksPerLocale do on Locales[i%numLocales] {
+  count.add(1);
+}
+writeln(count.read() == numLocales*tasksPerLocale);
+
+// All tasks on one locale, none on the others.
+var onZero: atomic int;
+coforall i in 1..numLocales*tasksPerLocale do on Locales[0] do onZero.add(i);
+writeln(onZero.read() == (numLocales*tasksPerLocale)*(numLocales*tasksPerLocale+1)/2);
+
+// Below the ratio: no leaves.
+var sum: atomic int;
+coforall loc in Locales do on loc do sum.add(loc.id+1);
+writeln(sum.read() == numLocales*(numLocales+1)/2);
+
+// Unbounded: the end count is decremented directly.
+iter gen() { for i in 1..5 do yield i; }
+var n: atomic int;
+coforall i in gen() do on Locales[numLocales-1] do n.add(i);
+writeln(n.read());
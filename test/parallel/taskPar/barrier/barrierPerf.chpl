@@ -0,0 +1,49 @@
+/*
+This test measures barrier latency as the number of tasks per locale and
+the number of locales grow.  For each barrier type and for tasks per
+locale in 1, 2, 4, ... maxTasksPerLocale, it times M barriers among
+numLocales*tasks tasks running SPMD-style, one group of tasks per locale.
+*/
+
+use Barrier, Time;
+
+config const perf = false; // performance or --fast mode
+config const reportTime = perf;
+
+config const maxTasksPerLocale = if perf then here.maxTaskPar else 4;
+config const M = if perf then 1000 else 10;
+
+proc runTest(barrierType: BarrierType, tasks: int) {
+  var b = new Barrier(numLocales * tasks, barrierType);
+  var timer: Timer;
+
+  // warm up, then time
+  coforall loc in Locales do on loc do
+    coforall tid in 0..#tasks do
+      b.barrier();
+
+  timer.start();
+  coforall loc in Locales do on loc do
+    coforall tid in 0..#tasks do
+      for i in 1..M do
+        b.barrier();
+  timer.stop();
+
+  const elapsed = if reportTime then (timer.elapsed() / M * 1e6) + " usec"
+                                else "";
+  writeln(barrierType, " ", tasks, " tasks/locale: ", elapsed);
+}
+
+proc main() {
+  if reportTime then
+    writeln(numLocales, " locale(s)  reps: ", M);
+
+  for barrierType in (BarrierType.Atomic, BarrierType.Dissemination,
+                      BarrierType.Tree) {
+    var tasks = 1;
+    while tasks <= maxTasksPerLocale {
+      runTest(barrierType, tasks);
+      tasks *= 2;
+    }
+  }
+}
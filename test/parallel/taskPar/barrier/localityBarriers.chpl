@@ -0,0 +1,65 @@
+//
+// The Dissemination and Tree barriers gather the tasks on each locale
+// before synchronizing the locales.  Check that no task gets past a
+// barrier before every task has reached it, with both even and uneven
+// numbers of tasks per locale, and after a reset.
+//
+use Barrier;
+
+config const tasksPerLocale = 4;
+config const reps = 10;
+
+proc spmdTest(b: Barrier, tasksPerLocale) {
+  const numTasks = numLocales * tasksPerLocale;
+  var A: [0..#numTasks] int;
+  var errors: atomic int;
+
+  coforall loc in Locales do on loc do
+    coforall tid in 0..#tasksPerLocale {
+      const id = loc.id * tasksPerLocale + tid;
+      for r in 1..reps {
+        A[id] = r;
+        b.barrier();
+        for a in A do
+          if a != r then errors.add(1);
+        b.barrier();
+      }
+    }
+
+  writeln("spmd ", tasksPerLocale, " tasks/locale: ", errors.read(), " errors");
+}
+
+// The first numTasks%numLocales locales run one extra task.
+proc unevenTest(b: Barrier, numTasks) {
+  var arrived: atomic int;
+  var errors: atomic int;
+
+  coforall loc in Locales do on loc {
+    const myTasks = numTasks / numLocales +
+                    (if loc.id < numTasks % numLocales then 1 else 0);
+    coforall tid in 0..#myTasks {
+      for r in 1..reps {
+        arrived.add(1);
+        b.barrier();
+        if arrived.read() != r * numTasks then errors.add(1);
+        b.barrier();
+      }
+    }
+  }
+
+  writeln("uneven: ", errors.read(), " errors");
+}
+
+for barrierType in (BarrierType.Dissemination, BarrierType.Tree) {
+  writeln(barrierType);
+
+  var b = new Barrier(numLocales * tasksPerLocale, barrierType);
+  spmdTest(b, tasksPerLocale);
+
+  b.reset(numLocales * tasksPerLocale + numLocales/2 + 1);
+  unevenTest(b, numLocales * tasksPerLocale + numLocales/2 + 1);
+
+  // Fewer tasks than locales: only some locales take part.
+  b.reset(numLocales/2 + 1);
+  unevenTest(b, numLocales/2 + 1);
+}
@@ -0,0 +1,20 @@
+//
+// Hand values back and forth between two tasks through sync variables,
+// checking that waits are counted either as spin waits or as parks.
+//
+config const n = 10000;
+
+var ping$, pong$: sync int;
+var total = 0;
+
+cobegin with (ref total) {
+  for i in 1..n {
+    ping$ = i;
+    total += pong$;
+  }
+  for i in 1..n do
+    pong$ = ping$ * 2;
+}
+
+writeln(total == n*(n+1));
+writeln(here.syncSpinWaits() + here.syncParks() > 0);
@@ -0,0 +1,36 @@
+// --report-vectorized-loops lists the order independent loops of user
+// code after LLVM has optimized them, and whether each was vectorized.
+// The first forall's follower loop carries no dependences between iterations
+// and is marked as parallel, so LLVM should vectorize it.  The second
+// forall's follower may call halt(), so LLVM can't vectorize it and the
+// report must say so, although it is order independent too.
+
+config const n = 1000;
+
+var A, B, C: [0..#n] real;
+
+iter elems(n: int) {
+  for i in 0..#n do yield i;
+}
+
+iter elems(n: int, param tag: iterKind) where tag == iterKind.leader {
+  yield 0..#n;
+}
+
+iter elems(n: int, followThis, param tag: iterKind)
+  where tag == iterKind.follower {
+  for i in followThis do yield i;
+}
+
+for i in elems(n) {
+  B[i] = i;
+  C[i] = 2 * i;
+}
+
+forall i in elems(n) do
+  A[i] = B[i] + C[i];
+
+forall i in elems(n) do
+  if A[i] < 0 then halt("negative sum at ", i);
+
+writeln(A[0], " ", A[n-1]);
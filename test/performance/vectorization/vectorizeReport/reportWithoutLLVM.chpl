@@ -0,0 +1,2 @@
+// Without --llvm there is nothing to report on, so the flag only warns.
+writeln("Hello");
@@ -0,0 +1,19 @@
+// Real sums combine through atomics that start from -0.0, so a sum of
+// -0.0 values stays -0.0 however many tasks contribute to it.
+
+config const n = 1000;
+
+var A: [1..n] real = -0.0;
+writeln(+ reduce A);
+
+var s = -0.0;
+forall a in A with (+ reduce s) do s += a;
+writeln(s);
+
+var t = -0.0:real(32);
+coforall i in 1..4 with (+ reduce t) do t += -0.0:real(32);
+writeln(t);
+
+// A +0.0 addend still gives +0.0.
+A[n/2] = 0.0;
+writeln(+ reduce A);
@@ -0,0 +1,86 @@
+/*
+This test measures how the combine phase of reductions scales with the
+number of tasks.  Each task contributes a single value, so the time is
+dominated by combining the per-task states.  The coforall runs all of its
+tasks on one locale; the forall combines on each locale and then across
+locales.
+
+For each task count in 1, 2, 4, ... maxTasksPerLocale it times M reps of
+  - a coforall of numLocales*tasks tasks on one locale, with a sum
+    reduce intent
+  - a forall over numLocales*tasks Block-distributed elements, with
+    sum, min and max reduce intents
+*/
+
+use BlockDist, Time;
+
+config const perf = false; // performance or --fast mode
+config const reportTime = perf;
+
+config const maxTasksPerLocale = if perf then here.maxTaskPar else 4;
+config const M = if perf then 1000 else 10;
+
+var timer: Timer;
+var numFailures = 0;
+
+proc end(testName: string, tasks: int, numErrors: int) {
+  const elapsed = if reportTime then timer.elapsed() + " sec" else "";
+  const message = if numErrors then numErrors + " FAILURES: " else "success  ";
+  writeln(message, testName, " ", tasks, " tasks/locale: ", elapsed);
+  if numErrors then numFailures += 1;
+}
+
+proc coforallReduce(tasks: int) {
+  var numErrors = 0;
+
+  timer.clear();
+  timer.start();
+  for rep in 1..M {
+    var sum = 0;
+
+    coforall tid in 0..#numLocales*tasks with (+ reduce sum) do
+      sum += 1;
+
+    if sum != numLocales * tasks then
+      numErrors += 1;
+  }
+  timer.stop();
+
+  end("coforall reduce", tasks, numErrors);
+}
+
+proc forallReduce(tasks: int) {
+  const D = {0..#numLocales*tasks} dmapped Block({0..#numLocales*tasks});
+  var numErrors = 0;
+
+  timer.clear();
+  timer.start();
+  for rep in 1..M {
+    var sum = 0.0, mn = max(int), mx = min(int);
+
+    forall i in D with (+ reduce sum, min reduce mn, max reduce mx) {
+      sum += 1.0;
+      mn = min(mn, i);
+      mx = max(mx, i);
+    }
+
+    if sum != numLocales * tasks || mn != 0 || mx != numLocales * tasks - 1 then
+      numErrors += 1;
+  }
+  timer.stop();
+
+  end("forall reduce", tasks, numErrors);
+}
+
+proc main() {
+  var tasks = 1;
+
+  while tasks <= maxTasksPerLocale {
+    coforallReduce(tasks);
+    forallReduce(tasks);
+    tasks *= 2;
+  }
+
+  if numFailures then writeln(numFailures, " FAILURES");
+  else writeln("all tests succeeded");
+}
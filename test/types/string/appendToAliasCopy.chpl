@@ -0,0 +1,19 @@
+// Appending to a copy of a string that aliases another string's buffer
+// must not write into that buffer, even when it has room to spare.
+
+var t = "abcdefghij" + "";
+t += "k";                 // t now has spare capacity
+var b = t.localize();     // b aliases t's buffer
+var c = b;
+c += "XY";
+writeln(t, " ", t.length, " ", t.c_str():string);
+writeln(c);
+
+proc passThrough(s: string) {
+  var r = s;
+  r += "!";
+  return r;
+}
+
+writeln(passThrough(t.localize()));
+writeln(t, " ", t.c_str():string);
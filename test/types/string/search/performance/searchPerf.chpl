@@ -0,0 +1,125 @@
+/*
+    Performance test of substring search.  Times find, rfind, count, split
+    and replace over a log-like text, and compares find, rfind and count
+    against the byte-by-byte search String used before they were handed to
+    the runtime's memchr and Two-Way based search.
+
+    Note: The correctness test for this is simply checking that the two
+          searches agree with each other.
+ */
+
+use Time;
+
+config const n = 1000,                // lines of text
+             correctness = true;      // Disables timing output
+
+proc main() {
+  var text: string;
+  for i in 1..n do
+    text += "2017-10-19 12:00:00,INFO,worker-" + i%16 + ",request " + i +
+            " served in " + i%97 + " ms\n";
+  const lastLine = "request " + n + " served in " + n%97 + " ms";
+  const firstLine = "worker-1,request 1 served in 1 ms";
+
+  var t = new Timer();
+
+  t.start();
+  const missing = text.find("WARN");
+  t.stop();
+  report('find short needle', t);
+
+  t.start();
+  const naiveMissing = naiveFind(text, "WARN");
+  t.stop();
+  report('naive find short needle', t);
+
+  t.start();
+  const last = text.find(lastLine);
+  t.stop();
+  report('find long needle', t);
+
+  t.start();
+  const naiveLast = naiveFind(text, lastLine);
+  t.stop();
+  report('naive find long needle', t);
+
+  t.start();
+  const first = text.rfind(firstLine);
+  t.stop();
+  report('rfind long needle', t);
+
+  t.start();
+  const naiveFirst = naiveRfind(text, firstLine);
+  t.stop();
+  report('naive rfind long needle', t);
+
+  t.start();
+  const commas = text.count(",");
+  t.stop();
+  report('count', t);
+
+  t.start();
+  const naiveCommas = naiveCount(text, ",");
+  t.stop();
+  report('naive count', t);
+
+  t.start();
+  var fields = 0;
+  for line in text.split("\n", ignoreEmpty=true) do
+    for field in line.split(",") do
+      fields += 1;
+  t.stop();
+  report('split', t);
+
+  t.start();
+  const replaced = text.replace(",", "\t");
+  t.stop();
+  report('replace', t);
+
+  if missing != naiveMissing || last != naiveLast || first != naiveFirst ||
+     commas != naiveCommas then
+    writeln('runtime search disagrees with naive search');
+  if missing != 0 || last == 0 || first == 0 || commas != 3*n then
+    writeln('wrong search results');
+  if fields != 4*n || replaced.count("\t") != 3*n then
+    writeln('wrong split or replace results');
+}
+
+// The brute-force search String.find, String.rfind and String.count used
+// to do
+proc naiveFind(s: string, needle: string) {
+  for i in 0..#(s.length - needle.length + 1) {
+    for j in 0..#needle.length {
+      if s.buff[i+j] != needle.buff[j] then break;
+      if j == needle.length-1 then return i+1;
+    }
+  }
+  return 0;
+}
+
+proc naiveRfind(s: string, needle: string) {
+  for i in 0..#(s.length - needle.length + 1) by -1 {
+    for j in 0..#needle.length {
+      if s.buff[i+j] != needle.buff[j] then break;
+      if j == needle.length-1 then return i+1;
+    }
+  }
+  return 0;
+}
+
+proc naiveCount(s: string, needle: string) {
+  var count = 0;
+  for i in 0..#(s.length - needle.length + 1) {
+    for j in 0..#needle.length {
+      if s.buff[i+j] != needle.buff[j] then break;
+      if j == needle.length-1 then count += 1;
+    }
+  }
+  return count;
+}
+
+proc report(name, ref t) {
+  if !correctness then
+    writeln(name, ' (seconds): ', t.elapsed());
+  t.clear();
+}
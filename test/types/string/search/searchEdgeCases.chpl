@@ -0,0 +1,32 @@
+// Exercises the corners of find, rfind, count, replace and split: empty
+// needles, regions, strided regions, overlapping matches and needles long
+// enough to use the runtime's Two-Way search.
+const s = "the quick brown fox jumps over the lazy dog; the end";
+
+writeln(s.find("the"), " ", s.rfind("the"), " ", s.count("the"), " ", s.count("e"));
+writeln(s.find("the", 2..), " ", s.rfind("the", ..40), " ", s.count("the", 5..48));
+writeln(s.find("lazy dog; the end"), " ", s.find("lazy dog; the endx"),
+        " ", s.rfind("jumps over the lazy"));
+writeln(s.find(""), " ", s.rfind(""), " ", s.count(""), " ",
+        "".count(""), " ", "".find("a"), " ", "".rfind(""));
+writeln("aaaa".count("aa"), " ", "abababab".find("babababab"),
+        " ", "abaabaabaabaabaab".count("abaabaab"));
+writeln(s.find("o", 1..20 by 2), " ", s.count("o", 1..s.length by 3));
+
+writeln(s.replace("the", "THE"));
+writeln(s.replace("the", "", 2));
+writeln("aaa".replace("a", "bb"), " ", "abc".replace("", "x"), " [",
+        "abc".replace("abc", ""), "] ", "aaaa".replace("aa", "a"));
+
+proc show(it) {
+  for x in it do write("[", x, "]");
+  writeln();
+}
+show("a,b,,c,".split(","));
+show("a::b::c".split("::", 1));
+show("abc".split(""));
+show("".split(","));
+show(",a,,b,".split(",", ignoreEmpty=true));
+show("one<sep-long>two<sep-long>three".split("<sep-long>"));
+
+writeln(s.startsWith("the q", "x"), " ", s.endsWith("end"), " ", s.endsWith("x"));